@@ -0,0 +1,89 @@
+/*
+    BENCHMARK: SIMD vs scalar integer parsing in FastInput
+    ======================================================
+    Writes inputs shaped like our problems to temporary files and parses every integer
+    with each parser kind (scalar loop, SSE4.1, AVX2). Kinds the CPU doesn't support are skipped,
+    and the one detectIntegerParser() picks by default is marked.
+
+    Inputs:
+      • range queries: "N Q", N values up to 1e9, then Q lines "t a b"      (N = Q = 2e5)
+      • tree edges:    "n", then n - 1 lines "u v"                          (n = 2e5)
+      • large:         1e7 values up to 1e18, one per line
+
+    Build & run:
+        g++ -O2 -std=c++20 Fast_Input_Benchmark.cpp -o bench && ./bench
+*/
+
+#include <fcntl.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include "../common/Fast_Input.h"
+using namespace std;
+
+const int REPEATS = 20;
+
+string writeInput(const char* path, const string& text) {
+    FILE* file = fopen(path, "w");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+    return path;
+}
+
+string rangeQueriesInput(mt19937_64& rng) {
+    const int n = 200000, q = 200000;
+    string text = to_string(n) + " " + to_string(q) + "\n";
+    for (int i = 0; i < n; ++i) text += to_string(rng() % 1000000000 + 1) + (i + 1 < n ? " " : "\n");
+    for (int i = 0; i < q; ++i) {
+        text += to_string(rng() % 2 + 1) + " " + to_string(rng() % n + 1) + " " + to_string(rng() % n + 1) + "\n";
+    }
+    return text;
+}
+
+string treeEdgesInput(mt19937_64& rng) {
+    const int n = 200000;
+    string text = to_string(n) + "\n";
+    for (int v = 2; v <= n; ++v) text += to_string(rng() % (v - 1) + 1) + " " + to_string(v) + "\n";
+    return text;
+}
+
+string largeInput(mt19937_64& rng) {
+    const int count = 10000000;
+    string text;
+    for (int i = 0; i < count; ++i) text += to_string(rng() % 1000000000000000000ULL) + "\n";
+    return text;
+}
+
+void measure(const char* name, const string& path) {
+    const char* kindNames[] = {"scalar", "sse4.1", "avx2"};
+    const IntegerParser chosen = detectIntegerParser();
+    double scalarTime = 0;
+    for (IntegerParser kind : {IntegerParser::Scalar, IntegerParser::Sse41, IntegerParser::Avx2}) {
+        if (!integerParserSupported(kind)) continue;
+        long long checksum = 0, count = 0;
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r) {
+            int fd = open(path.c_str(), O_RDONLY);
+            FastInput input(fd, kind);
+            while (!input.eof()) {
+                checksum += input.readInt<long long>();
+                ++count;
+            }
+            close(fd);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / REPEATS;
+        if (kind == IntegerParser::Scalar) scalarTime = seconds;
+        printf("  %-14s %-7s %8.2f ms  %6.2f ns/int  (x%.2f)  checksum %lld%s\n", name, kindNames[(int)kind],
+               seconds * 1e3, seconds * 1e9 * REPEATS / count, scalarTime / seconds, checksum,
+               kind == chosen ? "  (default)" : "");
+    }
+}
+
+int main() {
+    mt19937_64 rng(2024);
+    measure("range queries", writeInput("/tmp/fast_input_range.txt", rangeQueriesInput(rng)));
+    measure("tree edges", writeInput("/tmp/fast_input_tree.txt", treeEdgesInput(rng)));
+    measure("large 1e7", writeInput("/tmp/fast_input_large.txt", largeInput(rng)));
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+    BENCHMARK: SegmentTreeBeats vs a loop of point updates
+    ======================================================
+    Without segment tree beats, "clamp arr[l..r] to at most x" has to be a loop over the range
+    that calls updateValue() on every element above x, here on a SUM and a MAX SegmentTree
+    (../common/Segment_Tree.h) so that both queries stay O(log n). Range add is the same loop.
+
+    Workloads (N = 2e5, Q = 300), every fourth operation a sum or max query:
+      • Shrinking clamp  - chmin over a random range with a bound that keeps decreasing, so
+                           every clamp lowers a large part of the array. The loop pays for
+                           every lowered element; beats only for the distinct values it merges.
+      • Add + clamp      - random range adds (which split equal values apart again) alternating
+                           with chmin / chmax over the whole array. This is the case behind
+                           the O(log² n) amortized bound of beats.
+      • Random mix       - chmin / chmax / add with random bounds over random ranges.
+    The loop baseline is O(n) per update, so the workloads are kept short; both engines run the
+    same operations and their query checksums are compared.
+
+    Build & run:
+        g++ -O2 -std=c++20 Segment_Tree_Beats_Benchmark.cpp -o bench && ./bench
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../common/Segment_Tree.h"
+#include "../common/Segment_Tree_Beats.h"
+using namespace std;
+
+enum OperationType { CHMIN, CHMAX, ADD, SUM_QUERY, MAX_QUERY };
+
+struct Operation {
+    OperationType type;
+    int l, r;
+    long long x;
+};
+
+struct Workload {
+    vector<long long> nums;
+    vector<Operation> operations;
+};
+
+// Clamping by looping over the range, with the array kept next to the two trees
+class PointUpdateLoop {
+    vector<long long> values;
+    SegmentTree<SumMonoid<long long>> sums;
+    SegmentTree<MaxMonoid<long long>> maxima;
+
+    void assign(int i, long long value) {
+        values[i] = value;
+        sums.updateValue(i, value);
+        maxima.updateValue(i, value);
+    }
+
+public:
+    PointUpdateLoop(const vector<long long>& nums)
+        : values(nums), sums(nums.data(), nums.size()), maxima(nums.data(), nums.size()) {}
+
+    void rangeChmin(int l, int r, long long x) {
+        for (int i = l; i <= r; ++i) if (values[i] > x) assign(i, x);
+    }
+    void rangeChmax(int l, int r, long long x) {
+        for (int i = l; i <= r; ++i) if (values[i] < x) assign(i, x);
+    }
+    void rangeAdd(int l, int r, long long x) {
+        for (int i = l; i <= r; ++i) assign(i, values[i] + x);
+    }
+    long long querySum(int l, int r) { return sums.query(l, r); }
+    long long queryMax(int l, int r) { return maxima.query(l, r); }
+};
+
+struct Beats : SegmentTreeBeats<long long> {
+    Beats(const vector<long long>& nums) : SegmentTreeBeats(nums.data(), nums.size()) {}
+};
+
+pair<int, int> randomRange(mt19937& rng, int n) {
+    int l = rng() % n, r = rng() % n;
+    return {min(l, r), max(l, r)};
+}
+
+Workload makeWorkload(int kind, int n, int q, unsigned seed) {
+    mt19937 rng(seed);
+    Workload w;
+    w.nums.resize(n);
+    for (auto& x : w.nums) x = rng() % 1000000000;
+
+    long long bound = 1000000000;
+    for (int i = 0; i < q; ++i) {
+        auto [l, r] = randomRange(rng, n);
+        Operation op{SUM_QUERY, l, r, 0};
+        if (i % 4 == 3) op.type = rng() % 2 ? SUM_QUERY : MAX_QUERY;
+        else if (kind == 0) {
+            bound -= bound / 200;
+            op = {CHMIN, l, r, bound};
+        } else if (kind == 1) {
+            if (i % 4 == 0) op = {ADD, l, r, (long long)(rng() % 2000000) - 1000000};
+            else op = {i % 4 == 1 ? CHMIN : CHMAX, 0, n - 1, 400000000 + (long long)(rng() % 200000000)};
+        } else {
+            op = {OperationType(rng() % 3), l, r, (long long)(rng() % 1000000000)};
+            if (op.type == ADD) op.x = (long long)(rng() % 2000000) - 1000000;
+        }
+        w.operations.push_back(op);
+    }
+    return w;
+}
+
+template <class Engine>
+double runOperations(Engine& engine, const Workload& w, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (const auto& op : w.operations) {
+        switch (op.type) {
+            case CHMIN: engine.rangeChmin(op.l, op.r, op.x); break;
+            case CHMAX: engine.rangeChmax(op.l, op.r, op.x); break;
+            case ADD: engine.rangeAdd(op.l, op.r, op.x); break;
+            case SUM_QUERY: checksum ^= engine.querySum(op.l, op.r); break;
+            case MAX_QUERY: checksum ^= engine.queryMax(op.l, op.r); break;
+        }
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void benchmark(const char* name, int kind, int n, int q) {
+    Workload w = makeWorkload(kind, n, q, 12345);
+    long long loopChecksum = 0, beatsChecksum = 0;
+
+    PointUpdateLoop loop(w.nums);
+    double tLoop = runOperations(loop, w, loopChecksum);
+    Beats beats(w.nums);
+    double tBeats = runOperations(beats, w, beatsChecksum);
+
+    printf("%-16s Q=%d: point-update loop %.3fs  beats %.4fs  (x%.0f)%s\n", name, q, tLoop, tBeats,
+           tLoop / tBeats, loopChecksum == beatsChecksum ? "" : "  MISMATCH");
+}
+
+int main() {
+    benchmark("Shrinking clamp", 0, 200000, 300);
+    benchmark("Add + clamp", 1, 200000, 300);
+    benchmark("Random mix", 2, 200000, 300);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+    BENCHMARK: node layouts of the recursive SegmentTree
+    =====================================================
+    Compares SegmentTree<MinMonoid<long long>, long long, Layout> for
+      • HeapLayout        - children of i at 2i+1 / 2i+2 (the default)
+      • BlockedLayout<3>  - 3 levels (7 nodes) per 64-byte cache line
+      • BlockedLayout<4>  - 4 levels (15 nodes) per two cache lines
+    (see ../common/Node_Layouts.h).
+
+    Workload: random long long array of size N, 1e7 random range queries and 1e7 random
+    point updates. Besides the time per operation, the benchmark counts how many distinct
+    64-byte lines and 4 KB pages an average query touches. That count is computed from the
+    layout (it is not a hardware counter), but it is what the layout is meant to reduce:
+    once the tree is much larger than the cache, nearly every line below the top levels
+    is a cache miss.
+
+    Pass the sizes to try on the command line (default: 1e6 1e7). 1e8 needs about 2 GB per tree.
+
+    Build & run:
+        g++ -O2 -std=c++20 Segment_Tree_Layout_Benchmark.cpp -o bench && ./bench 1000000 10000000
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../common/Segment_Tree.h"
+using namespace std;
+
+const int NUM_OPERATIONS = 10000000;
+const int NUM_COUNTED_QUERIES = 100000;
+
+// Replays the descent of SegmentTree::rangeQuery and records the slot of every visited node
+template <class Layout>
+void collectSlots(const Layout& layout, int segmentStart, int segmentEnd, size_t segmentIndex, int depth,
+                  int queryStart, int queryEnd, vector<size_t>& slots) {
+    slots.push_back(layout.position(segmentIndex, depth));
+    if (queryStart <= segmentStart && segmentEnd <= queryEnd) return;
+    if (queryEnd < segmentStart || segmentEnd < queryStart) return;
+    int mid = segmentStart + (segmentEnd - segmentStart) / 2;
+    collectSlots(layout, segmentStart, mid, 2 * segmentIndex + 1, depth + 1, queryStart, queryEnd, slots);
+    collectSlots(layout, mid + 1, segmentEnd, 2 * segmentIndex + 2, depth + 1, queryStart, queryEnd, slots);
+}
+
+size_t countDistinct(vector<size_t>& blocks) {
+    sort(blocks.begin(), blocks.end());
+    return unique(blocks.begin(), blocks.end()) - blocks.begin();
+}
+
+template <class Layout>
+void measure(const char* name, const vector<long long>& nums, const vector<pair<int, int>>& ranges,
+             const vector<pair<int, long long>>& updates) {
+    const int n = nums.size();
+    auto start = chrono::steady_clock::now();
+    SegmentTree<MinMonoid<long long>, long long, Layout> tree(nums.data(), n);
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (auto [l, r] : ranges) checksum += tree.query(l, r);
+    double queryTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (auto [i, value] : updates) tree.updateValue(i, value);
+    double updateTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    int height = 1;
+    while ((1 << (height - 1)) < n) ++height;
+    Layout layout(height);
+    vector<size_t> slots, lines, pages;
+    double totalLines = 0, totalPages = 0;
+    for (int q = 0; q < NUM_COUNTED_QUERIES; ++q) {
+        slots.clear();
+        collectSlots(layout, 0, n - 1, 0, 0, ranges[q].first, ranges[q].second, slots);
+        lines.clear();
+        pages.clear();
+        for (size_t slot : slots) {
+            lines.push_back(slot * sizeof(long long) / 64);
+            pages.push_back(slot * sizeof(long long) / 4096);
+        }
+        totalLines += countDistinct(lines);
+        totalPages += countDistinct(pages);
+    }
+
+    printf("  %-17s memory %7.1f MB  build %6.3fs  query %6.1f ns  update %6.1f ns  "
+           "lines/query %5.1f  pages/query %5.1f  (checksum %lld)\n",
+           name, tree.memoryUsage() / 1e6, buildTime, queryTime * 1e9 / ranges.size(),
+           updateTime * 1e9 / updates.size(), totalLines / NUM_COUNTED_QUERIES,
+           totalPages / NUM_COUNTED_QUERIES, checksum);
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {1000000, 10000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+    }
+
+    for (int n : sizes) {
+        mt19937_64 rng(n);
+        vector<long long> nums(n);
+        for (auto& x : nums) x = rng() % 1000000000;
+        vector<pair<int, int>> ranges(NUM_OPERATIONS);
+        for (auto& [l, r] : ranges) {
+            l = rng() % n;
+            r = rng() % n;
+            if (l > r) swap(l, r);
+        }
+        vector<pair<int, long long>> updates(NUM_OPERATIONS);
+        for (auto& [i, value] : updates) {
+            i = rng() % n;
+            value = rng() % 1000000000;
+        }
+
+        printf("N = %d\n", n);
+        measure<HeapLayout>("HeapLayout", nums, ranges, updates);
+        measure<BlockedLayout<3>>("BlockedLayout<3>", nums, ranges, updates);
+        measure<BlockedLayout<4>>("BlockedLayout<4>", nums, ranges, updates);
+    }
+    return 0;
+}
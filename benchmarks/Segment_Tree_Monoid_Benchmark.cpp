@@ -0,0 +1,145 @@
+/*
+    BENCHMARK: enum-dispatched SegmentTree vs monoid-templated SegmentTree
+    =======================================================================
+    Compares the old SegmentTree (runtime `switch (operationType)` inside combineValues and
+    getNeutralValue) against SegmentTree<Monoid> from ../common/Segment_Tree.h.
+
+    Workload: random array, then Q operations where half are point updates and half are
+    range queries, for SUM and MIN. Sizes: N = Q = 2e5 (CSES limits) and N = 1e7 with Q = 2e6.
+
+    Build & run:
+        g++ -O2 -std=c++20 Segment_Tree_Monoid_Benchmark.cpp -o bench && ./bench
+*/
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../common/Segment_Tree.h"
+using namespace std;
+
+// The SegmentTree as it was before the monoid template, kept here only as a baseline
+class EnumSegmentTree {
+public:
+    enum OperationType { MAX, MIN, SUM };
+
+private:
+    int n;
+    OperationType operationType;
+    vector<long long> segTree;
+
+    long long getNeutralValue() const {
+        switch (operationType) {
+            case MAX: return LLONG_MIN;
+            case MIN: return LLONG_MAX;
+            case SUM: return 0;
+        }
+        return 0;
+    }
+
+    long long combineValues(long long leftValue, long long rightValue) const {
+        switch (operationType) {
+            case MAX: return max(leftValue, rightValue);
+            case MIN: return min(leftValue, rightValue);
+            case SUM: return leftValue + rightValue;
+        }
+        return 0;
+    }
+
+    long long build(const int arr[], int s, int e, int idx) {
+        if (s == e) return segTree[idx] = arr[s];
+        int mid = s + (e - s) / 2;
+        long long l = build(arr, s, mid, 2 * idx + 1);
+        long long r = build(arr, mid + 1, e, 2 * idx + 2);
+        return segTree[idx] = combineValues(l, r);
+    }
+
+    long long rangeQuery(int s, int e, int idx, int qs, int qe) const {
+        if (qs <= s && e <= qe) return segTree[idx];
+        if (qe < s || e < qs) return getNeutralValue();
+        int mid = s + (e - s) / 2;
+        return combineValues(rangeQuery(s, mid, 2 * idx + 1, qs, qe),
+                             rangeQuery(mid + 1, e, 2 * idx + 2, qs, qe));
+    }
+
+    void pointUpdate(int s, int e, int idx, int pos, int value) {
+        if (pos < s || e < pos) return;
+        if (s == e) { segTree[idx] = value; return; }
+        int mid = s + (e - s) / 2;
+        pointUpdate(s, mid, 2 * idx + 1, pos, value);
+        pointUpdate(mid + 1, e, 2 * idx + 2, pos, value);
+        segTree[idx] = combineValues(segTree[2 * idx + 1], segTree[2 * idx + 2]);
+    }
+
+public:
+    EnumSegmentTree(const int arr[], int n, OperationType type) : n(n), operationType(type) {
+        segTree.resize(4 * n + 5, getNeutralValue());
+        build(arr, 0, n - 1, 0);
+    }
+    long long query(int l, int r) const { return rangeQuery(0, n - 1, 0, l, r); }
+    void updateValue(int pos, int value) { pointUpdate(0, n - 1, 0, pos, value); }
+};
+
+struct Operation { int type, a, b; };
+
+struct Workload {
+    vector<int> nums;
+    vector<Operation> operations;
+};
+
+Workload makeWorkload(int n, int q, unsigned seed) {
+    mt19937 rng(seed);
+    Workload w;
+    w.nums.resize(n);
+    for (int& x : w.nums) x = rng() % 1000000000;
+    w.operations.resize(q);
+    for (auto& op : w.operations) {
+        op.type = rng() & 1;
+        if (op.type == 0) {
+            op.a = rng() % n;
+            op.b = rng() % 1000000000;
+        } else {
+            op.a = rng() % n;
+            op.b = rng() % n;
+            if (op.a > op.b) swap(op.a, op.b);
+        }
+    }
+    return w;
+}
+
+template <class Tree>
+double runOperations(Tree& tree, const Workload& w, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (const auto& op : w.operations) {
+        if (op.type == 0) tree.updateValue(op.a, op.b);
+        else checksum ^= tree.query(op.a, op.b);
+    }
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void benchmark(const char* name, int n, int q) {
+    Workload w = makeWorkload(n, q, 12345);
+    long long c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+
+    EnumSegmentTree enumSum(w.nums.data(), n, EnumSegmentTree::SUM);
+    double tEnumSum = runOperations(enumSum, w, c1);
+    SegmentTree<SumMonoid<long long>> monoidSum(w.nums.data(), n);
+    double tMonoidSum = runOperations(monoidSum, w, c2);
+
+    EnumSegmentTree enumMin(w.nums.data(), n, EnumSegmentTree::MIN);
+    double tEnumMin = runOperations(enumMin, w, c3);
+    SegmentTree<MinMonoid<long long>> monoidMin(w.nums.data(), n);
+    double tMonoidMin = runOperations(monoidMin, w, c4);
+
+    printf("%-22s SUM: enum %.3fs  monoid %.3fs  (x%.2f)%s\n", name, tEnumSum, tMonoidSum,
+           tEnumSum / tMonoidSum, c1 == c2 ? "" : "  MISMATCH");
+    printf("%-22s MIN: enum %.3fs  monoid %.3fs  (x%.2f)%s\n", name, tEnumMin, tMonoidMin,
+           tEnumMin / tMonoidMin, c3 == c4 ? "" : "  MISMATCH");
+}
+
+int main() {
+    benchmark("N=2e5, Q=2e5", 200000, 200000);
+    benchmark("N=1e7, Q=2e6", 10000000, 2000000);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+    BENCHMARK: short-range scan in front of the range-query engines
+    ================================================================
+    Compares each engine alone against ShortRangeScan<Monoid, Engine>
+    (../common/Short_Range_Scan.h) on three query mixes:
+      • short  - every range has 1..64 elements
+      • mixed  - half short ranges, half random ranges [l, r]
+      • long   - only random ranges [l, r]
+    with the threshold the constructor calibrates, and prints it next to the engine's default
+    (ShortRangeScanThreshold) together with the construction time, which includes the
+    calibration. Run it a few times to check that the calibrated value does not move.
+
+    Workload: random long long array of size N, 1e7 queries per mix.
+    Pass the sizes to try on the command line (default: 2e5 1e6).
+
+    Build & run:
+        g++ -O2 -std=c++20 Short_Range_Scan_Benchmark.cpp -o bench && ./bench 200000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../common/Short_Range_Scan.h"
+#include "../common/Wide_Segment_Tree.h"
+#include "../common/Fenwick_Tree.h"
+using namespace std;
+
+const int NUM_QUERIES = 10000000;
+
+template <class Engine>
+double timeQueries(const Engine& engine, const vector<pair<int, int>>& ranges, long long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (auto [l, r] : ranges) checksum += engine.query(l, r);
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count() * 1e9 / ranges.size();
+}
+
+template <class Monoid, class Engine>
+void measure(const char* name, const vector<long long>& nums, const vector<vector<pair<int, int>>>& mixes) {
+    const int n = nums.size();
+    Engine engine(nums.data(), n);
+    auto start = chrono::steady_clock::now();
+    ShortRangeScan<Monoid, Engine> hybrid(nums.data(), n);
+    double constructionTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("  %-16s threshold %4d (default %d), built in %.2f ms\n", name, hybrid.scanThreshold(),
+           ShortRangeScanThreshold<Engine>::value, constructionTime * 1e3);
+    const char* mixNames[] = {"short", "mixed", "long"};
+    for (int m = 0; m < 3; ++m) {
+        long long engineSum = 0, hybridSum = 0;
+        double engineTime = timeQueries(engine, mixes[m], engineSum);
+        double hybridTime = timeQueries(hybrid, mixes[m], hybridSum);
+        printf("    %-6s engine %6.1f ns   with scan %6.1f ns   %s\n", mixNames[m], engineTime, hybridTime,
+               engineSum == hybridSum ? "" : "CHECKSUM MISMATCH");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {200000, 1000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+    }
+
+    for (int n : sizes) {
+        mt19937_64 rng(n);
+        vector<long long> nums(n);
+        for (auto& x : nums) x = rng() % 1000000000;
+
+        auto shortRange = [&]() {
+            int length = 1 + rng() % 64;
+            int l = rng() % (n - length + 1);
+            return make_pair(l, l + length - 1);
+        };
+        auto longRange = [&]() {
+            int l = rng() % n, r = rng() % n;
+            if (l > r) swap(l, r);
+            return make_pair(l, r);
+        };
+        vector<vector<pair<int, int>>> mixes(3, vector<pair<int, int>>(NUM_QUERIES));
+        for (int i = 0; i < NUM_QUERIES; ++i) {
+            mixes[0][i] = shortRange();
+            mixes[1][i] = i % 2 ? shortRange() : longRange();
+            mixes[2][i] = longRange();
+        }
+
+        printf("N = %d\n", n);
+        measure<MinMonoid<long long>, WideSegmentTree<MinMonoid<long long>>>("WideSegmentTree", nums, mixes);
+        measure<SumMonoid<long long>, FenwickTree<long long>>("FenwickTree", nums, mixes);
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+    BENCHMARK: static range minimum query engines
+    ==============================================
+    Compares memory and query latency of
+      • SegmentTree<MinMonoid>  (../common/Segment_Tree.h)  - O(n) memory, O(log n) query
+      • SparseTable<MinMonoid>  (../common/Sparse_Table.h)  - O(n log n) memory, O(1) query
+      • BlockRMQ<MinMonoid>     (../common/Block_RMQ.h)     - O(n) memory, O(1) query
+
+    Workload: random long long array of size N and 1e7 random ranges [l, r].
+    Pass the sizes to try on the command line (default: 1e5 1e6 1e7). Each engine is
+    destroyed before the next one is built, so the sizes only have to fit one at a time.
+
+    Build & run:
+        g++ -O2 -std=c++20 Static_RMQ_Benchmark.cpp -o bench && ./bench 1000000 10000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../common/Segment_Tree.h"
+#include "../common/Sparse_Table.h"
+#include "../common/Block_RMQ.h"
+using namespace std;
+
+const int NUM_QUERIES = 10000000;
+
+template <class Engine>
+void measure(const char* name, const vector<long long>& nums, const vector<pair<int, int>>& ranges) {
+    auto start = chrono::steady_clock::now();
+    Engine engine(nums.data(), (int)nums.size());
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (auto [l, r] : ranges) checksum += engine.query(l, r);
+    double queryTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("  %-12s memory %9.1f MB   build %7.3fs   query %7.1f ns   (checksum %lld)\n", name,
+           engine.memoryUsage() / 1e6, buildTime, queryTime * 1e9 / ranges.size(), checksum);
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {100000, 1000000, 10000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+    }
+
+    for (int n : sizes) {
+        mt19937_64 rng(n);
+        vector<long long> nums(n);
+        for (auto& x : nums) x = rng() % 1000000000;
+        vector<pair<int, int>> ranges(NUM_QUERIES);
+        for (auto& [l, r] : ranges) {
+            l = rng() % n;
+            r = rng() % n;
+            if (l > r) swap(l, r);
+        }
+
+        printf("N = %d\n", n);
+        measure<SegmentTree<MinMonoid<long long>>>("SegmentTree", nums, ranges);
+        measure<SparseTable<MinMonoid<long long>>>("SparseTable", nums, ranges);
+        measure<BlockRMQ<MinMonoid<long long>>>("BlockRMQ", nums, ranges);
+    }
+    return 0;
+}
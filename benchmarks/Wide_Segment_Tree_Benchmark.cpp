@@ -0,0 +1,86 @@
+/*
+    BENCHMARK: wide (8-ary, AVX2) segment tree against the binary engines
+    ======================================================================
+    Compares query and point-update latency of
+      • IterativeSegmentTree  (../common/Iterative_Segment_Tree.h)  - binary, bottom-up
+      • WideSegmentTree       (../common/Wide_Segment_Tree.h)       - 8 children per node
+      • FenwickTree           (../common/Fenwick_Tree.h)            - SUM only
+      • SparseTable           (../common/Sparse_Table.h)            - MIN only, no updates
+    for MIN and SUM over long long.
+
+    Workload: random array of size N, 1e7 random ranges [l, r] and 1e7 random point updates.
+    Pass the sizes to try on the command line (default: 2e5 1e6 1e7).
+
+    Build & run:
+        g++ -O2 -std=c++20 Wide_Segment_Tree_Benchmark.cpp -o bench && ./bench 200000 1000000
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../common/Iterative_Segment_Tree.h"
+#include "../common/Wide_Segment_Tree.h"
+#include "../common/Fenwick_Tree.h"
+#include "../common/Sparse_Table.h"
+using namespace std;
+
+const int NUM_OPERATIONS = 10000000;
+
+template <class Engine, bool WITH_UPDATES = true>
+void measure(const char* name, const vector<long long>& nums, const vector<pair<int, int>>& ranges,
+             const vector<pair<int, long long>>& updates) {
+    Engine engine(nums.data(), (int)nums.size());
+
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (auto [l, r] : ranges) checksum += engine.query(l, r);
+    double queryTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double updateTime = 0;
+    if constexpr (WITH_UPDATES) {
+        start = chrono::steady_clock::now();
+        for (auto [i, value] : updates) engine.updateValue(i, value);
+        updateTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        for (int q = 0; q < 1000; ++q) checksum += engine.query(ranges[q].first, ranges[q].second);
+    }
+
+    printf("  %-22s query %7.1f ns   update %7.1f ns   (checksum %lld)\n", name,
+           queryTime * 1e9 / ranges.size(), updateTime * 1e9 / updates.size(), checksum);
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {200000, 1000000, 10000000};
+    if (argc > 1) {
+        sizes.clear();
+        for (int i = 1; i < argc; ++i) sizes.push_back(atoi(argv[i]));
+    }
+
+    for (int n : sizes) {
+        mt19937_64 rng(n);
+        vector<long long> nums(n);
+        for (auto& x : nums) x = rng() % 1000000000;
+        vector<pair<int, int>> ranges(NUM_OPERATIONS);
+        for (auto& [l, r] : ranges) {
+            l = rng() % n;
+            r = rng() % n;
+            if (l > r) swap(l, r);
+        }
+        vector<pair<int, long long>> updates(NUM_OPERATIONS);
+        for (auto& [i, value] : updates) {
+            i = rng() % n;
+            value = rng() % 1000000000;
+        }
+
+        printf("N = %d, MIN\n", n);
+        measure<IterativeSegmentTree<MinMonoid<long long>>>("IterativeSegmentTree", nums, ranges, updates);
+        measure<WideSegmentTree<MinMonoid<long long>>>("WideSegmentTree", nums, ranges, updates);
+        measure<SparseTable<MinMonoid<long long>>, false>("SparseTable", nums, ranges, updates);
+        printf("N = %d, SUM\n", n);
+        measure<IterativeSegmentTree<SumMonoid<long long>>>("IterativeSegmentTree", nums, ranges, updates);
+        measure<WideSegmentTree<SumMonoid<long long>>>("WideSegmentTree", nums, ranges, updates);
+        measure<FenwickTree<long long>>("FenwickTree", nums, ranges, updates);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+/*
+    AVX2 LANE OPERATIONS FOR THE SIMD ENGINES
+    =========================================
+    Building blocks shared by WideSegmentTree (Wide_Segment_Tree.h) and ShortRangeScan
+    (Short_Range_Scan.h): the combine() of SUM / MIN / MAX applied to 4 long longs at once,
+    and folding the 4 lanes of a register into one value.
+
+    Everything here is compiled with target("avx2"), like the kernels in
+    Simd_Integer_Parser.h, so callers must check the CPU first (cpuSupportsAvx2()).
+    AVX2 has no 64-bit min/max instruction, so MIN and MAX compare and blend.
+*/
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+inline bool cpuSupportsAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// Lane-wise combine of 4 long longs, one struct per monoid
+struct SumLanes {
+    __attribute__((target("avx2"))) static __m256i combine(__m256i a, __m256i b) {
+        return _mm256_add_epi64(a, b);
+    }
+};
+
+struct MinLanes {
+    __attribute__((target("avx2"))) static __m256i combine(__m256i a, __m256i b) {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+};
+
+struct MaxLanes {
+    __attribute__((target("avx2"))) static __m256i combine(__m256i a, __m256i b) {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+    }
+};
+
+// combine() of the 4 lanes of `lanes`
+template <class Lanes>
+__attribute__((target("avx2"))) inline long long foldLanes(__m256i lanes) {
+    lanes = Lanes::combine(lanes, _mm256_permute2x128_si256(lanes, lanes, 1));          // 2 lanes
+    lanes = Lanes::combine(lanes, _mm256_shuffle_epi32(lanes, _MM_SHUFFLE(1, 0, 3, 2)));  // 1 lane
+    return _mm256_extract_epi64(lanes, 0);
+}
+
+#else
+
+inline bool cpuSupportsAvx2() {
+    return false;
+}
+
+#endif
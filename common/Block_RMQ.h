@@ -0,0 +1,129 @@
+/*
+    LINEAR-MEMORY RANGE MINIMUM (OR MAXIMUM) QUERIES
+    ================================================
+    Answers static range MIN/MAX queries in O(1) like SparseTable (Sparse_Table.h), but with
+    O(n) memory instead of O(n log n). A sparse table over 1e8 long longs needs ~21 GB,
+    this structure needs ~1.9 GB (the values, one 64-bit mask per position and a small
+    sparse table over block minima).
+
+IDEA:
+    Split the array into blocks of 64 elements.
+
+    1. Across blocks: build a SparseTable over the minimum of every block.
+       It has n/64 entries per level, so it takes n/64 * log(n/64) < n words.
+
+    2. Inside a block: for every position i, run the classic "monotonic stack" from the
+       start of the block up to i. The stack after processing i holds exactly the positions j
+       for which arr[j] is the minimum of [j, i]. Since a block has 64 positions, that stack
+       fits in one 64-bit mask (bit j set ⇔ block position j is on the stack).
+
+       The minimum of [l, i] (both in the same block) is then the first stack position ≥ l:
+           mask[i] >> (l - blockStart), take its lowest set bit (count trailing zeros).
+
+RANGE QUERY [l, r]:
+    • Same block:      one mask lookup + one ctz
+    • Different blocks: suffix of l's block + sparse table over the full blocks in between
+                        + prefix of r's block (prefix and suffix are both in-block queries)
+
+    Time Complexity: O(n) build, O(1) per query
+    Space Complexity: O(n)
+
+    Only selective monoids (whose combine returns one of its two arguments) work here,
+    so the structure accepts MinMonoid and MaxMonoid.
+
+USAGE:
+    BlockRMQ<MinMonoid<long long>> rmq(array, size);
+    long long result = rmq.query(left, right);
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "Monoids.h"
+#include "Sparse_Table.h"
+
+template <class Monoid> struct IsSelectiveMonoid : std::false_type {};
+template <class T> struct IsSelectiveMonoid<MinMonoid<T>> : std::true_type {};
+template <class T> struct IsSelectiveMonoid<MaxMonoid<T>> : std::true_type {};
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class BlockRMQ {
+    static_assert(IsSelectiveMonoid<Monoid>::value, "BlockRMQ only supports MinMonoid and MaxMonoid");
+
+    static const int BLOCK_BITS = 6;
+    static const int BLOCK_SIZE = 1 << BLOCK_BITS;
+
+    int n;
+    std::vector<T> values;
+    std::vector<uint64_t> stackMask;
+    std::vector<T> blockResults;
+    SparseTable<Monoid, T> blockTable;
+
+    // true if a strictly beats b, e.g. a < b for MIN
+    static bool beats(const T& a, const T& b) {
+        return !(Monoid::combine(b, a) == b);
+    }
+
+    // Answer for [l, r] when both lie in the same block
+    T inBlockQuery(int l, int r) const {
+        uint64_t mask = stackMask[r] >> (l & (BLOCK_SIZE - 1));
+        return values[l + __builtin_ctzll(mask)];
+    }
+
+    template <class U>
+    static std::vector<T> blockMinima(const U arr[], int n) {
+        std::vector<T> result((n + BLOCK_SIZE - 1) >> BLOCK_BITS, Monoid::identity());
+        for (int i = 0; i < n; ++i) {
+            result[i >> BLOCK_BITS] = Monoid::combine(result[i >> BLOCK_BITS], T(arr[i]));
+        }
+        return result;
+    }
+
+public:
+    template <class U>
+    BlockRMQ(const U arr[], int n)
+        : n(n),
+          values(arr, arr + n),
+          stackMask(n),
+          blockResults(blockMinima(arr, n)),
+          blockTable(blockResults.data(), (int)blockResults.size()) {
+
+        for (int blockStart = 0; blockStart < n; blockStart += BLOCK_SIZE) {
+            uint64_t mask = 0;
+            int blockEnd = std::min(n, blockStart + BLOCK_SIZE);
+            for (int i = blockStart; i < blockEnd; ++i) {
+                // Pop every stack element that the new value beats. The stack is
+                // monotonic, so those are the highest set bits of the mask.
+                while (mask && beats(values[i], values[blockStart + 63 - __builtin_clzll(mask)])) {
+                    mask ^= 1ULL << (63 - __builtin_clzll(mask));
+                }
+                mask |= 1ULL << (i - blockStart);
+                stackMask[i] = mask;
+            }
+        }
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        int leftBlock = rangeStart >> BLOCK_BITS;
+        int rightBlock = rangeEnd >> BLOCK_BITS;
+        if (leftBlock == rightBlock) return inBlockQuery(rangeStart, rangeEnd);
+
+        T result = Monoid::combine(
+            inBlockQuery(rangeStart, (leftBlock << BLOCK_BITS) + BLOCK_SIZE - 1),
+            inBlockQuery(rightBlock << BLOCK_BITS, rangeEnd)
+        );
+        if (leftBlock + 1 < rightBlock) {
+            result = Monoid::combine(result, blockTable.query(leftBlock + 1, rightBlock - 1));
+        }
+        return result;
+    }
+
+    // Bytes used by this structure (without the input array)
+    size_t memoryUsage() const {
+        return values.capacity() * sizeof(T) + stackMask.capacity() * sizeof(uint64_t)
+             + blockResults.capacity() * sizeof(T) + blockTable.memoryUsage();
+    }
+};
@@ -0,0 +1,127 @@
+/*
+    FENWICK TREE (BINARY INDEXED TREE)
+    ==================================
+    Range SUM queries and point updates in O(log n) using only n + 1 words.
+    It only works for invertible operations (range [l, r] = prefix(r) - prefix(l - 1)),
+    so for MIN/MAX use one of the segment trees instead.
+
+TREE STRUCTURE (1-indexed internally):
+    • bit[i] stores the sum of arr over (i - lowbit(i), i], where lowbit(i) = i & -i
+    • prefix(i) walks i -= lowbit(i), update(i) walks i += lowbit(i); both are tight
+      loops of at most log n steps with no branches besides the loop condition
+
+ALGORITHMS:
+
+    Linear Build:
+      Copy arr into bit[], then push every node into its parent once:
+          bit[i + lowbit(i)] += bit[i]
+      This gives the same tree as n point updates in O(n) instead of O(n log n).
+
+    Point Add / Assign:
+      addValue(i, delta) adds delta along the update path.
+      updateValue(i, value) turns an assignment into an add. The current value of arr[i]
+      is recovered from the tree itself instead of keeping a second copy of the array:
+      bit[i] covers (i - lowbit(i), i], so subtracting the nodes that cover
+      (i - lowbit(i), i - 1] leaves arr[i]. That loop is O(1) on average.
+
+    Range Sum [l, r]:
+      prefix(r) - prefix(l - 1)
+
+    Lower Bound by Prefix Sum:
+      Finds the smallest index i with arr[0] + ... + arr[i] ≥ target, assuming all values
+      are non-negative (so prefix sums are non-decreasing). Instead of binary searching over
+      prefix() calls (O(log² n)), descend bit by bit from the highest power of two: at each
+      step try to extend the current position by 2^k if that keeps the sum below target.
+
+    Batched Range Sums:
+      queryBatch() has the same interface as the segment trees, but it is a plain loop.
+      The nodes a prefix walk visits depend only on the index, never on loaded values, so
+      the CPU already overlaps the cache misses of consecutive queries. Lock-step walks and
+      software prefetching were measured to be no faster here.
+
+    Time Complexity: O(n) build, O(log n) per operation
+    Space Complexity: O(n)
+
+USAGE:
+    FenwickTree<long long> tree(array, size);
+    long long result = tree.query(left, right);   // Range sum
+    tree.updateValue(index, newValue);            // Point assign
+    tree.addValue(index, delta);                  // Point add
+    long long value = tree.valueAt(index);        // Single element
+    int position = tree.lowerBound(target);       // First prefix sum ≥ target (n if none)
+    tree.queryBatch(ranges, answers);             // span<const pair<int, int>>, span<long long>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+template <class T>
+class FenwickTree {
+    int n;
+    std::vector<T> bit;     // 1-indexed
+
+    T prefix(int count) const {
+        T result = T(0);
+        for (int i = count; i > 0; i -= i & -i) result += bit[i];
+        return result;
+    }
+
+public:
+    template <class U>
+    FenwickTree(const U arr[], int n) {
+        this->n = n;
+        bit.assign(n + 1, T(0));
+        for (int i = 1; i <= n; ++i) bit[i] = T(arr[i - 1]);
+        for (int i = 1; i <= n; ++i) {
+            int parent = i + (i & -i);
+            if (parent <= n) bit[parent] += bit[i];
+        }
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        return prefix(rangeEnd + 1) - prefix(rangeStart);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        for (size_t i = 0; i < ranges.size(); ++i) out[i] = query(ranges[i].first, ranges[i].second);
+    }
+
+    T valueAt(int index) const {
+        int i = index + 1;
+        T result = bit[i];
+        for (int j = i - 1, stop = i - (i & -i); j > stop; j -= j & -j) result -= bit[j];
+        return result;
+    }
+
+    void addValue(int index, const T& delta) {
+        for (int i = index + 1; i <= n; i += i & -i) bit[i] += delta;
+    }
+
+    void updateValue(int index, const T& newValue) {
+        addValue(index, newValue - valueAt(index));
+    }
+
+    int lowerBound(T target) const {
+        int position = 0;
+        int step = 1;
+        while (step * 2 <= n) step *= 2;
+        for (; step > 0; step >>= 1) {
+            if (position + step <= n && bit[position + step] < target) {
+                position += step;
+                target -= bit[position];
+            }
+        }
+        // position is the number of elements whose sum is still below target
+        return position;
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return bit.capacity() * sizeof(T);
+    }
+};
@@ -0,0 +1,155 @@
+/*
+    GROWABLE SEGMENT TREE (PUSH_BACK / POP_BACK)
+    ============================================
+    Same interface as IterativeSegmentTree (query / updateValue / queryBatch), plus
+    push_back(value) and pop_back(), so the array can grow and shrink at its end while it is
+    being queried. The other trees fix n when they are built: in SegmentTree the segment of
+    every node depends on n (the root splits [0, n - 1] at its midpoint), and
+    IterativeSegmentTree keeps its leaves at n + i, so adding one element means a rebuild.
+
+TREE STRUCTURE:
+    • One vector per level: levels[0] holds the array, and node i of levels[k] combines nodes
+      2i and 2i + 1 of levels[k - 1], so it always covers the elements [i·2^k, (i+1)·2^k).
+    • Level k has ceil(n / 2^k) nodes. The last node of a level may be missing its right
+      child, then it equals its left child.
+    • The segment of a node does not depend on n, so growing never moves or recomputes an
+      existing node: it only appends at the end of each level.
+
+ALGORITHMS:
+
+    push_back(value):
+      Append the leaf, then walk up: on every level, append a node if the level needs one
+      more, and recompute the ancestor of the new leaf. When the old top level had a single
+      node and now has two, a new top level is added. Each level is a std::vector, so its
+      capacity doubles when it is full: appends cost amortized O(1) copying per level and
+      never recompute anything outside the new leaf's path, O(log n) in total.
+
+    pop_back():
+      Remove the last leaf, shrink every level to its new size, recompute the last node of
+      each level (it may have lost its right child) and drop top levels that are no longer
+      needed. O(log n); capacity is kept for the next push_back().
+
+    Range Query [l, r] and Point Update:
+      The bottom-up walks of IterativeSegmentTree, one level per step. Node indices on each
+      level stay below the level's size, so the missing right children are never read.
+
+    Time Complexity: O(n) build, O(log n) per query, update, push_back and pop_back
+                     (push_back amortized: a level occasionally moves to a buffer twice as large)
+    Space Complexity: O(2n) nodes, at most twice that in reserved capacity
+
+USAGE:
+    GrowableSegmentTree<SumMonoid<long long>> tree(array, size);  // Or tree() to start empty
+    tree.push_back(value);
+    tree.pop_back();
+    long long result = tree.query(left, right);
+    tree.updateValue(index, newValue);
+    tree.reserve(capacity);                 // Optional: no reallocation up to `capacity` elements
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class GrowableSegmentTree {
+    // levels[0] is the array. The first level with at most one node is the top, the levels
+    // above it are empty (left by pop_back() or reserve() for the tree to grow into).
+    std::vector<std::vector<T>> levels;
+
+    // Recomputes node `index` of level `level` from the level below
+    void recompute(size_t level, size_t index) {
+        const std::vector<T>& below = levels[level - 1];
+        const size_t left = 2 * index, right = 2 * index + 1;
+        levels[level][index] = right < below.size() ? Monoid::combine(below[left], below[right]) : below[left];
+    }
+
+public:
+    GrowableSegmentTree() : levels(1) {}
+
+    template <class U>
+    GrowableSegmentTree(const U arr[], int n) : levels(1) {
+        levels[0].assign(arr, arr + n);
+        while (levels.back().size() > 1) {
+            const size_t size = (levels.back().size() + 1) / 2;
+            levels.emplace_back(size);
+            for (size_t i = 0; i < size; ++i) recompute(levels.size() - 1, i);
+        }
+    }
+
+    int size() const {
+        return levels[0].size();
+    }
+
+    bool empty() const {
+        return levels[0].empty();
+    }
+
+    // Reserves every level for `capacity` elements, so push_back() never reallocates below that
+    void reserve(size_t capacity) {
+        for (size_t level = 0, size = capacity; ; ++level, size = (size + 1) / 2) {
+            if (level == levels.size()) levels.emplace_back();
+            levels[level].reserve(size);
+            if (size <= 1) break;
+        }
+    }
+
+    void push_back(const T& value) {
+        levels[0].push_back(value);
+        size_t index = levels[0].size() - 1;
+        for (size_t level = 1; levels[level - 1].size() > 1; ++level) {
+            index >>= 1;
+            if (level == levels.size()) levels.emplace_back();
+            if (levels[level].size() <= index) levels[level].push_back(T());
+            recompute(level, index);
+        }
+    }
+
+    void pop_back() {
+        levels[0].pop_back();
+        size_t size = levels[0].size();
+        size_t level = 1;
+        for (; level < levels.size() && size > 1; ++level) {
+            size = (size + 1) / 2;
+            levels[level].resize(size);
+            recompute(level, size - 1);
+        }
+        // The level below now has at most one node: it is the new top
+        for (; level < levels.size(); ++level) levels[level].clear();
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        T leftResult = Monoid::identity(), rightResult = Monoid::identity();
+        size_t l = rangeStart, r = rangeEnd + 1;
+        for (size_t level = 0; l < r; ++level, l >>= 1, r >>= 1) {
+            const std::vector<T>& nodes = levels[level];
+            if (l & 1) leftResult = Monoid::combine(leftResult, nodes[l++]);
+            if (r & 1) rightResult = Monoid::combine(nodes[--r], rightResult);
+        }
+        return Monoid::combine(leftResult, rightResult);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        for (size_t i = 0; i < ranges.size(); ++i) out[i] = query(ranges[i].first, ranges[i].second);
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        levels[0][updateIndex] = newValue;
+        size_t index = updateIndex;
+        for (size_t level = 1; level < levels.size() && !levels[level].empty(); ++level) {
+            index >>= 1;
+            recompute(level, index);
+        }
+    }
+
+    // Bytes used by the tree, including reserved capacity
+    size_t memoryUsage() const {
+        size_t bytes = 0;
+        for (const auto& nodes : levels) bytes += nodes.capacity() * sizeof(T);
+        return bytes;
+    }
+};
@@ -0,0 +1,279 @@
+/*
+    INDEX SNAPSHOT (BINARY SAVE / MMAP RELOAD)
+    ==========================================
+    Saves the arrays of a built index (binary lifting tables, Euler tour, segment tree, ...)
+    to a binary file, and maps that file back on later runs over the same input, so the
+    program skips both parsing the tree and building the index and goes straight to the
+    queries.
+
+    Snapshots are only used when the environment variable INDEX_SNAPSHOT names a file:
+        INDEX_SNAPSHOT=tree.snap ./solution < input.txt     // 1st run: builds and writes tree.snap
+        INDEX_SNAPSHOT=tree.snap ./solution < input.txt     // Later runs: maps tree.snap
+    Without it (e.g. on the judge) nothing changes.
+
+FILE FORMAT (native byte order):
+    • Header: magic "IDXSNAP\0", format version, the name of the structure (chosen by the
+      program, including its own layout version), file size, number of sections, a checksum
+      of everything after the header, and where the input the index was built from starts
+      and ends, with a checksum of the whole input up to that end.
+    • Section table: name, offset, size in bytes and element size of every array.
+    • The arrays, each starting at a multiple of 64 bytes so they can be used in place.
+
+HOW IT WORKS:
+    • The snapshot is created right before the program reads the part of the input the index
+      is built from (usually after "n q"). save() records which bytes of the input the
+      build consumed, and writes the file under a temporary name and renames it, so a
+      crashed run never leaves half a snapshot behind.
+    • load() maps the file read-only and accepts it only if everything matches: magic,
+      format version, structure name, file size, section table, payload checksum, and the
+      checksum of the current input from its first byte to the same end. The input checksum
+      starts at byte 0 so that everything read before the build ("n q") is part of the key
+      too. Then the input is moved past the build's range. A stale or damaged snapshot is
+      simply ignored and the index is rebuilt.
+    • section<T>(name, count) returns the array as a span pointing into the mapping: nothing
+      is copied, and pages are only read when a query touches them (apart from the one
+      checksum pass in load()). It is empty unless the array has exactly `count` elements;
+      the caller then calls discard(), which also moves the input back, and builds.
+    • The checksum (Checksum.h) runs at memory speed, far cheaper than parsing the text
+      again. It can be fed piece by piece, so save() streams the arrays straight to the file.
+
+USAGE:
+    input >> n >> q;
+    IndexSnapshot snapshot(input, "Company_Queries_II_M1 v1");
+    if (snapshot.load()) {
+        up = snapshot.section<array<int, MAX_LOG>>("up", n + 1);
+        if (up.empty()) snapshot.discard();
+    }
+    if (!snapshot.loaded()) {
+        buildIndex();                   // Reads the tree from `input`
+        up = upBuilt;
+        snapshot.add("up", up);         // The data must stay alive until save()
+        snapshot.save();
+    }
+*/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+#include "Checksum.h"
+#include "Fast_Input.h"
+
+const uint32_t SNAPSHOT_FORMAT_VERSION = 2;
+
+class IndexSnapshot {
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion, sectionCount;
+        char structure[48];
+        uint64_t fileSize, payloadChecksum;
+        uint64_t inputStart, inputEnd, inputChecksum;     // The checksum covers [0, inputEnd)
+    };
+
+    struct Section {
+        char name[16];
+        uint64_t offset, bytes;
+        uint32_t elementSize, reserved;
+    };
+
+    static constexpr char MAGIC[8] = {'I', 'D', 'X', 'S', 'N', 'A', 'P', '\0'};
+    static const size_t ALIGNMENT = 64;
+
+    FastInput& input;
+    const char* path;
+    std::string structure;
+    size_t inputStart;
+
+    void* mappedData = nullptr;
+    size_t mappedSize = 0;
+
+    std::vector<Section> pendingSections;
+    std::vector<const void*> pendingData;
+
+    static size_t alignUp(size_t offset) {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    const Header& header() const {
+        return *static_cast<const Header*>(mappedData);
+    }
+
+    const Section* sections() const {
+        return reinterpret_cast<const Section*>(static_cast<const char*>(mappedData) + sizeof(Header));
+    }
+
+    void unmap() {
+        if (mappedData != nullptr) munmap(mappedData, mappedSize);
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+
+    // Everything in the mapped file is consistent and belongs to the current input
+    bool mappedSnapshotIsValid() const {
+        if (mappedSize < sizeof(Header)) return false;
+        const Header& head = header();
+        if (memcmp(head.magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+        if (head.formatVersion != SNAPSHOT_FORMAT_VERSION) return false;
+        if (strnlen(head.structure, sizeof(head.structure)) != structure.size()) return false;
+        if (memcmp(head.structure, structure.data(), structure.size()) != 0) return false;
+        if (head.fileSize != mappedSize) return false;
+        if (head.sectionCount > (mappedSize - sizeof(Header)) / sizeof(Section)) return false;
+
+        const char* base = static_cast<const char*>(mappedData);
+        for (uint32_t i = 0; i < head.sectionCount; ++i) {
+            const Section& section = sections()[i];
+            if (section.offset % ALIGNMENT != 0 || section.offset > mappedSize) return false;
+            if (section.bytes > mappedSize - section.offset) return false;
+            if (section.elementSize == 0 || section.bytes % section.elementSize != 0) return false;
+        }
+        if (checksum64(base + sizeof(Header), mappedSize - sizeof(Header)) != head.payloadChecksum) return false;
+
+        std::span<const char> text = input.bytes();
+        if (head.inputStart != inputStart || head.inputEnd < inputStart || head.inputEnd > text.size()) return false;
+        return checksum64(text.data(), head.inputEnd) == head.inputChecksum;
+    }
+
+public:
+    // Call right before reading the part of the input the index is built from
+    IndexSnapshot(FastInput& input, const char* structure, const char* path = getenv("INDEX_SNAPSHOT"))
+        : input(input), path(path), structure(structure), inputStart(input.position()) {}
+
+    ~IndexSnapshot() {
+        unmap();
+    }
+
+    IndexSnapshot(const IndexSnapshot&) = delete;
+    IndexSnapshot& operator=(const IndexSnapshot&) = delete;
+
+    // Maps the snapshot if there is a valid one for this input and skips the input it covers
+    bool load() {
+        if (path == nullptr) return false;
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                mappedData = data;
+                mappedSize = info.st_size;
+            }
+        }
+        close(fd);
+
+        if (mappedData == nullptr || !mappedSnapshotIsValid()) {
+            unmap();
+            return false;
+        }
+        input.seek(header().inputEnd);
+        return true;
+    }
+
+    bool loaded() const {
+        return mappedData != nullptr;
+    }
+
+    // Drops a loaded snapshot whose sections do not fit, and moves the input back to where
+    // the build reads it
+    void discard() {
+        if (!loaded()) return;
+        unmap();
+        input.seek(inputStart);
+    }
+
+    // The array saved under `name`, empty unless there is one with exactly `count` elements
+    // of type T
+    template <class T>
+    std::span<const T> section(const char* name, size_t count) const {
+        if (mappedData == nullptr) return {};
+        for (uint32_t i = 0; i < header().sectionCount; ++i) {
+            const Section& section = sections()[i];
+            if (strncmp(section.name, name, sizeof(section.name)) != 0) continue;
+            if (section.elementSize != sizeof(T) || section.bytes != count * sizeof(T)) return {};
+            const T* values = reinterpret_cast<const T*>(static_cast<const char*>(mappedData) + section.offset);
+            return {values, count};
+        }
+        return {};
+    }
+
+    // Queues an array for save(). Only trivially copyable element types make sense here.
+    template <class T>
+    void add(const char* name, std::span<const T> values) {
+        if (path == nullptr) return;
+        Section section{};
+        strncpy(section.name, name, sizeof(section.name) - 1);
+        section.bytes = values.size_bytes();
+        section.elementSize = sizeof(T);
+        pendingSections.push_back(section);
+        pendingData.push_back(values.data());
+    }
+
+    // Writes the queued arrays, tied to the input read since the constructor. The file is
+    // streamed piece by piece (no in-memory copy of the index); the header goes last.
+    bool save() {
+        if (path == nullptr || structure.size() >= sizeof(Header::structure)) return false;
+
+        const size_t tableEnd = sizeof(Header) + pendingSections.size() * sizeof(Section);
+        size_t fileSize = alignUp(tableEnd);
+        for (Section& section : pendingSections) {
+            section.offset = fileSize;
+            fileSize = alignUp(fileSize + section.bytes);
+        }
+
+        // Write under a temporary name and rename, so readers never see a partial file
+        const std::string temporaryPath = std::string(path) + ".tmp";
+        int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+
+        Checksum64 payload;
+        const char zeros[ALIGNMENT] = {};
+        size_t offset = 0;
+        bool ok = true;
+        auto writeBytes = [&](const void* data, size_t size, bool checksummed) {
+            const char* bytes = static_cast<const char*>(data);
+            if (checksummed) payload.add(bytes, size);
+            while (ok && size > 0) {
+                ssize_t count = write(fd, bytes, size);
+                if (count <= 0) ok = false;
+                else bytes += count, size -= count, offset += count;
+            }
+        };
+        auto padTo = [&](size_t target) { writeBytes(zeros, target - offset, true); };
+
+        const Header placeholder{};
+        writeBytes(&placeholder, sizeof(Header), false);       // Rewritten below
+        writeBytes(pendingSections.data(), pendingSections.size() * sizeof(Section), true);
+        padTo(alignUp(tableEnd));
+        for (size_t i = 0; i < pendingSections.size(); ++i) {
+            writeBytes(pendingData[i], pendingSections[i].bytes, true);
+            padTo(alignUp(offset));
+        }
+
+        Header head{};
+        memcpy(head.magic, MAGIC, sizeof(MAGIC));
+        head.formatVersion = SNAPSHOT_FORMAT_VERSION;
+        head.sectionCount = pendingSections.size();
+        memcpy(head.structure, structure.c_str(), structure.size() + 1);
+        head.fileSize = fileSize;
+        head.payloadChecksum = payload.result();
+        head.inputStart = inputStart;
+        head.inputEnd = input.position();
+        head.inputChecksum = checksum64(input.bytes().data(), head.inputEnd);
+        ok = ok && pwrite(fd, &head, sizeof(Header), 0) == (ssize_t)sizeof(Header);
+
+        close(fd);
+        if (!ok) {
+            unlink(temporaryPath.c_str());
+            return false;
+        }
+        return rename(temporaryPath.c_str(), path) == 0;
+    }
+};
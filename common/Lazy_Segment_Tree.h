@@ -0,0 +1,225 @@
+/*
+    LAZY SEGMENT TREE (RANGE UPDATES)
+    =================================
+    Extends the recursive SegmentTree (Segment_Tree.h) with range updates in O(log n):
+      • rangeAdd(l, r, x)              - arr[i] += x        for every i in [l, r]
+      • rangeAssign(l, r, x)           - arr[i]  = x
+      • rangeMultiplyAdd(l, r, a, b)   - arr[i]  = a * arr[i] + b
+    All three are the same kind of update: an affine function f(x) = a*x + b
+    (add is a = 1, assign is a = 0). Point updates and range queries work as before.
+
+KEY CONCEPTS:
+    1. Lazy Tags - Instead of updating every element of a fully covered segment, store the
+       pending update at the segment's node and apply it to the children only when a later
+       operation needs to go below that node ("push-down").
+    2. Composition - Two pending affine updates compose into one affine update
+       (AffineMonoid in Monoids.h), so every node needs only one tag.
+    3. Applying a tag to a stored result depends on the monoid:
+       • SUM:      a * sum + b * (segment length)
+       • MIN/MAX:  a * min + b   (needs a ≥ 0, otherwise MIN and MAX would swap; this is
+                                  asserted in rangeMultiplyAdd)
+
+ALGORITHMS:
+
+    Range Update [updateStart, updateEnd] with f:
+      1. No overlap       → return
+      2. Complete overlap → apply f to the node's value, compose f into the node's tag, return
+      3. Partial overlap  → push the node's tag down to both children, recurse into both,
+                            recalculate the node from its children
+
+    Range Query [queryStart, queryEnd]:
+      Same three cases as in SegmentTree, but before descending into the children of a
+      partially covered node, its tag is pushed down.
+
+    Only nodes on the visited paths are pushed, so both operations touch O(log n) nodes.
+
+    Time Complexity: O(n) build, O(log n) per update and query
+    Space Complexity: O(4n) values + O(4n) tags
+
+USAGE:
+    LazySegmentTree<SumMonoid<long long>> tree(array, size);   // or MinMonoid, MaxMonoid
+    tree.rangeAdd(left, right, 5);
+    tree.rangeAssign(left, right, 7);
+    tree.rangeMultiplyAdd(left, right, 2, 1);
+    tree.updateValue(index, newValue);
+    long long result = tree.query(left, right);
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include "Monoids.h"
+
+// How an affine update f changes the stored result of a segment with `length` elements.
+// NEEDS_NONNEGATIVE_A: only f with a ≥ 0 can be applied to the stored result.
+template <class Monoid> struct AffineAction;
+
+template <class T>
+struct AffineAction<SumMonoid<T>> {
+    static constexpr bool NEEDS_NONNEGATIVE_A = false;
+
+    static T apply(const Affine<T>& f, const T& sum, int length) {
+        return f.a * sum + f.b * T(length);
+    }
+};
+
+template <class T>
+struct AffineAction<MinMonoid<T>> {
+    // With a < 0 the new minimum would come from the old maximum, which is not stored
+    static constexpr bool NEEDS_NONNEGATIVE_A = true;
+
+    static T apply(const Affine<T>& f, const T& minimum, int) {
+        return f(minimum);
+    }
+};
+
+template <class T>
+struct AffineAction<MaxMonoid<T>> {
+    static constexpr bool NEEDS_NONNEGATIVE_A = true;
+
+    static T apply(const Affine<T>& f, const T& maximum, int) {
+        return f(maximum);
+    }
+};
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class LazySegmentTree {
+    using Action = AffineAction<Monoid>;
+    using Tag = Affine<T>;
+
+    int n;
+    std::vector<T> segTree;
+    std::vector<Tag> lazy;      // Pending update of every node, identity (1, 0) if none
+
+    int getMidpoint(int startPoint, int endPoint) const {
+        return startPoint + (endPoint - startPoint) / 2;
+    }
+
+    // Applies f to a whole segment: its stored value and its pending tag
+    void applyTag(const int segmentIndex, const int segmentLength, const Tag& f) {
+        segTree[segmentIndex] = Action::apply(f, segTree[segmentIndex], segmentLength);
+        lazy[segmentIndex] = AffineMonoid<T>::combine(lazy[segmentIndex], f);
+    }
+
+    // Hands the pending tag of a node over to its two children
+    void pushDown(const int segmentStart, const int segmentEnd, const int segmentIndex) {
+        if (lazy[segmentIndex] == AffineMonoid<T>::identity()) return;
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        applyTag((segmentIndex << 1) + 1, mid - segmentStart + 1, lazy[segmentIndex]);
+        applyTag((segmentIndex << 1) + 2, segmentEnd - mid, lazy[segmentIndex]);
+        lazy[segmentIndex] = AffineMonoid<T>::identity();
+    }
+
+    template <class U>
+    T buildSegTree(
+        const U arr[],
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex
+    ) {
+        // CASE 1: Segment size becomes one (leaf node)
+        if (segmentEnd == segmentStart) {
+            return segTree[segmentIndex] = T(arr[segmentEnd]);
+        }
+
+        // CASE 2: Segment size >= 2 (internal node)
+        int mid = getMidpoint(segmentStart, segmentEnd);
+
+        T leftValue  = buildSegTree(arr, segmentStart, mid, (segmentIndex << 1) + 1);
+        T rightValue = buildSegTree(arr, mid+1, segmentEnd, (segmentIndex << 1) + 2);
+
+        return segTree[segmentIndex] = Monoid::combine(leftValue, rightValue);
+    }
+
+    T rangeQuery(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int queryStart,
+        const int queryEnd
+    ) {
+        // CASE 1: Segment completely lies inside the query range
+        if (queryStart <= segmentStart && segmentEnd <= queryEnd) {
+            return segTree[segmentIndex];
+        }
+
+        // CASE 2: Segment completely lies outside the query range
+        if (queryEnd < segmentStart || segmentEnd < queryStart) {
+            return Monoid::identity();
+        }
+
+        // CASE 3: Segment partially overlaps with the query range
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        T leftValue  = rangeQuery(segmentStart, mid, (segmentIndex << 1) + 1, queryStart, queryEnd);
+        T rightValue = rangeQuery(mid+1, segmentEnd, (segmentIndex << 1) + 2, queryStart, queryEnd);
+
+        return Monoid::combine(leftValue, rightValue);
+    }
+
+    void rangeUpdate(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int updateStart,
+        const int updateEnd,
+        const Tag& f
+    ) {
+        // CASE 1: Segment completely lies outside the update range
+        if (updateEnd < segmentStart || segmentEnd < updateStart) {
+            return;
+        }
+
+        // CASE 2: Segment completely lies inside the update range - stop here and leave a tag
+        if (updateStart <= segmentStart && segmentEnd <= updateEnd) {
+            applyTag(segmentIndex, segmentEnd - segmentStart + 1, f);
+            return;
+        }
+
+        // CASE 3: Partial overlap - push the old tag down first, then update the children
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        rangeUpdate(segmentStart, mid, (segmentIndex << 1) + 1, updateStart, updateEnd, f);
+        rangeUpdate(mid+1, segmentEnd, (segmentIndex << 1) + 2, updateStart, updateEnd, f);
+
+        segTree[segmentIndex] = Monoid::combine(segTree[(segmentIndex << 1) + 1], segTree[(segmentIndex << 1) + 2]);
+    }
+
+public:
+    template <class U>
+    LazySegmentTree(const U arr[], int n) {
+        this->n = n;
+        segTree.resize(4 * n + 5, Monoid::identity());
+        lazy.resize(4 * n + 5, AffineMonoid<T>::identity());
+        buildSegTree(arr, 0, n - 1, 0);
+    }
+
+    // Not const: pushing tags down while descending changes the tree (but not its contents)
+    T query(const int rangeStart, const int rangeEnd) {
+        return rangeQuery(0, n - 1, 0, rangeStart, rangeEnd);
+    }
+
+    void updateValue(const int updateIndex, const T& newValue) {
+        rangeAssign(updateIndex, updateIndex, newValue);
+    }
+
+    void rangeMultiplyAdd(const int rangeStart, const int rangeEnd, const T& a, const T& b) {
+        if constexpr (Action::NEEDS_NONNEGATIVE_A) assert(a >= T(0) && "MIN/MAX trees only take a >= 0");
+        rangeUpdate(0, n - 1, 0, rangeStart, rangeEnd, Tag{a, b});
+    }
+
+    void rangeAdd(const int rangeStart, const int rangeEnd, const T& x) {
+        rangeMultiplyAdd(rangeStart, rangeEnd, T(1), x);
+    }
+
+    void rangeAssign(const int rangeStart, const int rangeEnd, const T& x) {
+        rangeMultiplyAdd(rangeStart, rangeEnd, T(0), x);
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return segTree.capacity() * sizeof(T) + lazy.capacity() * sizeof(Tag);
+    }
+};
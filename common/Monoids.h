@@ -0,0 +1,103 @@
+/*
+    MONOIDS FOR RANGE QUERY ENGINES
+    ===============================
+    A monoid is a pair (combine, identity) where combine is associative and
+    combine(identity, x) == combine(x, identity) == x for every x.
+
+    Every range query engine in this folder (SegmentTree, ...) is a template over
+    one of these structs instead of switching on an enum at runtime. Since the
+    operation is known at compile time, combine() is inlined into the tree loops
+    and the compiler is free to vectorize them.
+
+    A monoid struct must provide:
+      • ValueType            - the type stored in the tree
+      • identity()           - constexpr neutral element
+      • combine(left, right) - the operation itself (left is the earlier segment)
+      • idempotent           - true if combine(x, x) == x; engines that answer queries with
+                               overlapping segments (SparseTable) only accept such monoids
+
+    Writing your own monoid is a matter of copying one of the structs below.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+template <class T>
+struct SumMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = false;
+    static constexpr T identity() { return T(0); }
+    static constexpr T combine(const T& left, const T& right) { return left + right; }
+};
+
+template <class T>
+struct MinMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = true;
+    static constexpr T identity() { return std::numeric_limits<T>::max(); }
+    static constexpr T combine(const T& left, const T& right) { return std::min(left, right); }
+};
+
+template <class T>
+struct MaxMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = true;
+    static constexpr T identity() { return std::numeric_limits<T>::lowest(); }
+    static constexpr T combine(const T& left, const T& right) { return std::max(left, right); }
+};
+
+// gcd(0, x) == x, so 0 works as the identity element
+template <class T>
+struct GcdMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = true;
+    static constexpr T identity() { return T(0); }
+    static constexpr T combine(const T& left, const T& right) { return std::gcd(left, right); }
+};
+
+template <class T>
+struct XorMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = false;
+    static constexpr T identity() { return T(0); }
+    static constexpr T combine(const T& left, const T& right) { return left ^ right; }
+};
+
+template <class T>
+struct AndMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = true;
+    static constexpr T identity() { return ~T(0); }
+    static constexpr T combine(const T& left, const T& right) { return left & right; }
+};
+
+template <class T>
+struct OrMonoid {
+    using ValueType = T;
+    static constexpr bool idempotent = true;
+    static constexpr T identity() { return T(0); }
+    static constexpr T combine(const T& left, const T& right) { return left | right; }
+};
+
+// Linear function f(x) = a*x + b
+template <class T>
+struct Affine {
+    T a, b;
+    constexpr T operator()(const T& x) const { return a * x + b; }
+    constexpr bool operator==(const Affine& other) const { return a == other.a && b == other.b; }
+};
+
+// Composition of linear functions. Note that this monoid is NOT commutative:
+// combine(f, g) is "apply f first, then g", i.e. g(f(x)).
+template <class T>
+struct AffineMonoid {
+    using ValueType = Affine<T>;
+    static constexpr bool idempotent = false;
+    static constexpr Affine<T> identity() { return {T(1), T(0)}; }
+    static constexpr Affine<T> combine(const Affine<T>& first, const Affine<T>& second) {
+        return {second.a * first.a, second.a * first.b + second.b};
+    }
+};
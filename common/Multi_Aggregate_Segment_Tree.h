@@ -0,0 +1,166 @@
+/*
+    MULTI-AGGREGATE SEGMENT TREE (STRUCTURE OF ARRAYS)
+    ==================================================
+    One tree over one array that keeps five aggregates per node:
+      • sum
+      • min, the smallest index holding it (argmin) and how often it occurs (count of min)
+      • max
+    Any subset of them is answered with a single walk, and one updateValue() keeps all of
+    them current. Running a SUM tree and a MIN tree side by side would store the array
+    twice, walk twice per logical query and update twice.
+
+TREE STRUCTURE:
+    The bottom-up layout of IterativeSegmentTree (Iterative_Segment_Tree.h): the leaf of
+    arr[i] is node n + i and node i combines nodes 2i and 2i + 1, 2n nodes in total.
+    Each aggregate is its own array (structure of arrays), not a field of a node struct:
+      • A query for some of the aggregates only loads the arrays it needs. A sum query reads
+        8 bytes per node, not the 32 of a node holding everything.
+      • Consecutive nodes of one aggregate are contiguous, so the bottom-up rebuild is a
+        plain loop over each array.
+
+ALGORITHMS:
+
+    Combining two nodes a and b:
+      sum      = a.sum + b.sum
+      max      = max(a.max, b.max)
+      min      = min(a.min, b.min)
+      argmin   = the argmin of the side with the smaller min; on a tie the smaller of the two
+      minCount = the count of the side with the smaller min; on a tie their sum
+    Every rule is commutative, so the nodes that cover "wrapped" pieces of the array when n
+    is not a power of two, and the order in which the query walk meets nodes, do not matter.
+    The argmin is always the leftmost position of the minimum.
+
+    Range Query [l, r]:
+      The walk of IterativeSegmentTree::query(). The wanted aggregates are a template
+      parameter (a mask of AGGREGATE_* bits), so the code for the others is compiled out.
+      ARGMIN and MIN_COUNT need the min too, so they include MIN.
+
+    Point Update:
+      Write all five values of the leaf and recompute all five of each ancestor. That is five
+      arrays to write per level instead of one, so an update costs about three times as much
+      as in an IterativeSegmentTree (and more than updating a SUM and a MIN tree); a query
+      for sum and min together costs about half of querying both trees. The tree pays off
+      when queries outnumber updates.
+
+    Time Complexity: O(n) build, O(log n) per query and update
+    Space Complexity: 2n × (3 values + 2 ints)
+
+USAGE:
+    MultiAggregateSegmentTree<long long> tree(array, size);
+    RangeAggregates<long long> all = tree.query(left, right);        // Every aggregate
+    long long sum = tree.query<AGGREGATE_SUM>(left, right).sum;
+    auto low = tree.query<AGGREGATE_MIN | AGGREGATE_ARGMIN>(left, right);  // low.min, low.argmin
+    tree.updateValue(index, newValue);
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+const unsigned AGGREGATE_SUM = 1;
+const unsigned AGGREGATE_MIN = 2;
+const unsigned AGGREGATE_MAX = 4;
+const unsigned AGGREGATE_ARGMIN = 8 | AGGREGATE_MIN;
+const unsigned AGGREGATE_MIN_COUNT = 16 | AGGREGATE_MIN;
+const unsigned AGGREGATE_ALL = AGGREGATE_SUM | AGGREGATE_MAX | AGGREGATE_ARGMIN | AGGREGATE_MIN_COUNT;
+
+// Result of a query. Fields that were not asked for keep these identity values.
+template <class T>
+struct RangeAggregates {
+    T sum = T(0);
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    int argmin = -1;
+    int minCount = 0;
+};
+
+template <class T = long long>
+class MultiAggregateSegmentTree {
+    int n;
+    std::vector<T> sums, mins, maxs;
+    std::vector<int> argmins, minCounts;
+
+    // Folds node `node` into `result`, touching only the arrays in Fields
+    template <unsigned Fields>
+    void accumulate(RangeAggregates<T>& result, int node) const {
+        constexpr bool wantArgmin = (Fields & AGGREGATE_ARGMIN) == AGGREGATE_ARGMIN;
+        constexpr bool wantMinCount = (Fields & AGGREGATE_MIN_COUNT) == AGGREGATE_MIN_COUNT;
+
+        if constexpr ((Fields & AGGREGATE_SUM) != 0) result.sum += sums[node];
+        if constexpr ((Fields & AGGREGATE_MAX) != 0) {
+            if (maxs[node] > result.max) result.max = maxs[node];
+        }
+        if constexpr (wantArgmin || wantMinCount) {
+            const T value = mins[node];
+            if (value < result.min) {
+                result.min = value;
+                if constexpr (wantArgmin) result.argmin = argmins[node];
+                if constexpr (wantMinCount) result.minCount = minCounts[node];
+            } else if (value == result.min) {
+                // argmin is still -1 if the minimum is numeric_limits<T>::max(), the start value
+                if constexpr (wantArgmin) {
+                    if (result.argmin == -1 || argmins[node] < result.argmin) result.argmin = argmins[node];
+                }
+                if constexpr (wantMinCount) result.minCount += minCounts[node];
+            }
+        } else if constexpr ((Fields & AGGREGATE_MIN) != 0) {
+            if (mins[node] < result.min) result.min = mins[node];
+        }
+    }
+
+    // Recomputes all aggregates of an internal node from its two children. The child with
+    // the smaller min is picked once and its min, argmin and count are copied from it.
+    void pull(int node) {
+        const int left = node << 1, right = node << 1 | 1;
+        sums[node] = sums[left] + sums[right];
+        maxs[node] = maxs[left] < maxs[right] ? maxs[right] : maxs[left];
+
+        const int smaller = mins[right] < mins[left] ? right : left;
+        mins[node] = mins[smaller];
+        argmins[node] = argmins[smaller];
+        minCounts[node] = minCounts[smaller];
+        if (mins[left] == mins[right]) {
+            argmins[node] = argmins[left] < argmins[right] ? argmins[left] : argmins[right];
+            minCounts[node] = minCounts[left] + minCounts[right];
+        }
+    }
+
+    void setLeaf(int index, const T& value) {
+        const int node = n + index;
+        sums[node] = mins[node] = maxs[node] = value;
+        argmins[node] = index;
+        minCounts[node] = 1;
+    }
+
+public:
+    template <class U>
+    MultiAggregateSegmentTree(const U arr[], int n)
+        : n(n), sums(2 * n), mins(2 * n), maxs(2 * n), argmins(2 * n), minCounts(2 * n) {
+        for (int i = 0; i < n; ++i) setLeaf(i, T(arr[i]));
+        for (int i = n - 1; i > 0; --i) pull(i);
+    }
+
+    // The aggregates in Fields (AGGREGATE_* bits) of arr[rangeStart..rangeEnd]
+    template <unsigned Fields = AGGREGATE_ALL>
+    RangeAggregates<T> query(int rangeStart, int rangeEnd) const {
+        RangeAggregates<T> result;
+        for (int l = rangeStart + n, r = rangeEnd + n + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) accumulate<Fields>(result, l++);
+            if (r & 1) accumulate<Fields>(result, --r);
+        }
+        return result;
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        setLeaf(updateIndex, newValue);
+        for (int i = (updateIndex + n) >> 1; i > 0; i >>= 1) pull(i);
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return (sums.capacity() + mins.capacity() + maxs.capacity()) * sizeof(T) +
+               (argmins.capacity() + minCounts.capacity()) * sizeof(int);
+    }
+};
@@ -0,0 +1,155 @@
+/*
+    NODE LAYOUTS FOR THE RECURSIVE SEGMENT TREE
+    ===========================================
+    SegmentTree (Segment_Tree.h) always navigates with heap indices (children of i are
+    2i + 1 and 2i + 2), but where a node is *stored* is decided by a layout policy.
+    A layout maps (heap index, depth) to a slot in the node array.
+
+    Why it matters: with the plain heap order, the nodes of one root-to-leaf path are far
+    apart once n is in the millions. The top levels stay cached because every query uses
+    them, but every level below that costs one cache miss (and soon one TLB miss).
+
+LAYOUTS:
+
+    HeapLayout (default)
+    --------------------
+    slot = heap index. The classic 2i+1 / 2i+2 array, exactly as before.
+
+    BlockedLayout<LEVELS>
+    ---------------------
+    B-tree style grouping: the tree is cut into blocks of LEVELS consecutive levels, and
+    the 2^LEVELS - 1 nodes of each block are stored together (slot 0 of a block is padding,
+    so blocks stay aligned).
+    With 8-byte values and LEVELS = 3 one block is exactly one 64-byte cache line, so a
+    descent touches one line per 3 levels instead of one per level. Blocks of the same
+    block-level are stored left to right, block-levels top to bottom.
+
+    Every layout is constructed from the tree height (number of levels) and exposes
+        size()                                  - number of slots to allocate
+        position(heapIndex, depth)              - slot of a node (the root has depth 0)
+        child(slot, depth, side)                - slot of the left (side 0) / right (side 1)
+                                                  child of the node stored at `slot`
+    SegmentTree only uses child() while descending, so a layout can make it cheaper than a
+    full position() computation.
+
+    The node array is allocated with CacheLineAllocator, so blocks start on a cache line.
+
+MEASUREMENTS (benchmarks/Segment_Tree_Layout_Benchmark.cpp, MIN over long long, random ranges):
+
+                       lines/query   pages/query   query ns   update ns   memory
+    N = 1e6   Heap         40.2          21.0          595         296       17 MB
+              Blocked<3>   23.8           9.0          739         424       19 MB
+    N = 1e7   Heap         49.0          27.8          857         440      268 MB
+              Blocked<3>   29.8          11.8         1035         548      307 MB
+    N = 1e8   Heap         57.1          34.4         1102         729     2148 MB
+              Blocked<3>   33.9          13.9         1469         850     2454 MB
+
+    The blocked layout touches ~40% fewer cache lines and ~60% fewer pages, but on the test
+    machine (105 MB L3) it is still slower at every size. The nodes a query visits depend only
+    on l and r, never on loaded values, so the out-of-order core issues the heap layout's
+    misses in parallel. The extra index arithmetic per node then costs more than the misses
+    saved. A van Emde Boas order was also tried: about as many lines and pages as
+    BlockedLayout<4>, but computing a slot takes O(log log n) steps and queries were 2x slower,
+    so it is not included. HeapLayout stays the default.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// std::allocator that aligns every allocation to a 64-byte cache line
+template <class T>
+struct CacheLineAllocator {
+    using value_type = T;
+    static constexpr std::align_val_t ALIGNMENT{64};
+
+    CacheLineAllocator() = default;
+    template <class U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), ALIGNMENT));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, ALIGNMENT);
+    }
+
+    template <class U>
+    bool operator==(const CacheLineAllocator<U>&) const { return true; }
+};
+
+struct HeapLayout {
+    int height;
+
+    explicit HeapLayout(int height) : height(height) {}
+
+    size_t size() const {
+        return (size_t(1) << height) - 1;
+    }
+
+    size_t position(size_t heapIndex, int) const {
+        return heapIndex;
+    }
+
+    size_t child(size_t slot, int, int side) const {
+        return 2 * slot + 1 + side;
+    }
+};
+
+template <int LEVELS = 3>
+class BlockedLayout {
+    static_assert(LEVELS >= 1 && LEVELS <= 8, "a block holds 2^LEVELS slots");
+    static const size_t BLOCK = size_t(1) << LEVELS;
+
+    // Per depth: depth of the block roots of its block-level and the first slot of that level.
+    // The top block gets the leftover (height - 1) % LEVELS + 1 levels, so that all deeper
+    // blocks are full and every level down to the leaves wastes only the one padding slot.
+    int rootDepth[64];
+    size_t levelStart[64];
+    size_t totalSize;
+
+public:
+    explicit BlockedLayout(int height) {
+        const int topLevels = (height - 1) % LEVELS + 1;
+        size_t start = 0;
+        for (int firstDepth = 0; firstDepth < height; firstDepth = firstDepth == 0 ? topLevels : firstDepth + LEVELS) {
+            const int levels = firstDepth == 0 ? topLevels : LEVELS;
+            for (int depth = firstDepth; depth < firstDepth + levels; ++depth) {
+                rootDepth[depth] = firstDepth;
+                levelStart[depth] = start;
+            }
+            start += (size_t(1) << firstDepth) * BLOCK;
+        }
+        totalSize = start;
+    }
+
+    size_t size() const {
+        return totalSize;
+    }
+
+    size_t position(size_t heapIndex, int depth) const {
+        const size_t node = heapIndex + 1;            // 1-based heap index: node >> 1 is the parent
+        const int depthInBlock = depth - rootDepth[depth];
+        const size_t blockRoot = node >> depthInBlock;
+        const size_t block = blockRoot - (size_t(1) << rootDepth[depth]);
+        const size_t inBlock = node - ((blockRoot - 1) << depthInBlock);   // 1 .. 2^LEVELS - 1
+        return levelStart[depth] + block * BLOCK + inBlock;
+    }
+
+    // Inside a block the children of local node j are 2j and 2j + 1, like in a 1-based heap.
+    // From the bottom row of a block, the child is the root of block number
+    // block * 2^levels + (2j + side - 2^levels) on the next block-level.
+    size_t child(size_t slot, int depth, int side) const {
+        const int childDepth = depth + 1;
+        const size_t inBlock = slot & (BLOCK - 1);
+        const size_t sameBlock = slot + inBlock + side;
+        const int levels = childDepth - rootDepth[depth];
+        const size_t block = (slot - levelStart[depth]) / BLOCK;
+        const size_t childBlock = (block << levels) + 2 * inBlock + side - (size_t(1) << levels);
+        const size_t nextBlock = levelStart[childDepth] + childBlock * BLOCK + 1;
+        // Both candidates are computed so the choice compiles to a conditional move
+        return rootDepth[childDepth] == childDepth ? nextBlock : sameBlock;
+    }
+};
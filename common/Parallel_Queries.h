@@ -0,0 +1,96 @@
+/*
+    PARALLEL QUERY EXECUTION
+    ========================
+    Answers a batch of read-only queries on all cores. Once a structure is built and no
+    longer changes (SparseTable, binary lifting tables, an Euler tour segment tree, ...), the
+    queries are independent of each other, so they can be split between threads freely.
+
+HOW IT WORKS:
+    • The queries are split into one contiguous slice per worker. A worker answers its
+      slice and writes the answers into the same slice of a preallocated output array, so
+      workers share nothing but the read-only index and need no locks or atomics.
+    • Slice boundaries are moved to the start of a cache line of the output, so two workers
+      never write to the same line (no false sharing at the boundaries). The lines are found
+      from the output's real address: a std::vector is only 16-byte aligned, so counting
+      whole lines from its first element would still split lines. This needs the size of an
+      answer to divide 64 (long long, int, ...); otherwise the boundaries are not moved.
+    • The calling thread answers the first slice itself and then joins the others. The
+      answers end up in query order, so printing them afterwards in one pass gives exactly
+      the output of the serial program.
+    • Starting a thread costs tens of microseconds, so every worker gets at least
+      MIN_QUERIES_PER_WORKER queries. Small inputs and single-core machines run on the
+      calling thread only, without creating any thread.
+
+    The work function must only read shared state. Structures with scratch space in
+    mutable members (ShortRangeScan, ...) cannot be queried from several threads.
+
+    Time Complexity: O(Q / workers) per worker, plus O(workers) to start and join them
+    Space Complexity: O(workers) besides the output
+
+USAGE:
+    answers.resize(queries.size());
+    answerInParallel(queries, answers, [&](pair<int, int> query) { return lca(query.first, query.second); });
+    forEachSliceInParallel(count, [&](size_t begin, size_t end) { ... answer [begin, end) ... }, answers.data());
+    Build with -pthread.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+const size_t MIN_QUERIES_PER_WORKER = 1 << 14;
+const size_t CACHE_LINE_SIZE = 64;
+
+// Number of threads worth starting for `count` queries
+inline int parallelWorkerCount(size_t count) {
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::clamp<size_t>(count / MIN_QUERIES_PER_WORKER, 1, cores);
+}
+
+// Calls work(begin, end) for consecutive slices covering [0, count), each on its own thread.
+// If `output` is the array the slices write to (output[i] for query i), every slice but the
+// first starts at a cache line boundary of it.
+template <class Work, class Answer = char>
+void forEachSliceInParallel(size_t count, Work work, const Answer* output = nullptr) {
+    const int workers = parallelWorkerCount(count);
+    if (workers == 1) {
+        if (count > 0) work(0, count);
+        return;
+    }
+
+    // Boundaries are firstLine + k * answersPerLine: output[firstLine] starts a line
+    size_t answersPerLine = 1, firstLine = 0;
+    if (output && CACHE_LINE_SIZE % sizeof(Answer) == 0) {
+        const size_t gap = (CACHE_LINE_SIZE - (uintptr_t)output % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+        if (gap % sizeof(Answer) == 0) {
+            answersPerLine = CACHE_LINE_SIZE / sizeof(Answer);
+            firstLine = gap / sizeof(Answer);
+        }
+    }
+    auto sliceStart = [&](int w) {
+        size_t start = std::max(firstLine, (count * w + workers - 1) / workers);
+        start = firstLine + (start - firstLine + answersPerLine - 1) / answersPerLine * answersPerLine;
+        return std::min(count, start);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (int w = 1; w < workers; ++w) {
+        const size_t begin = sliceStart(w), end = w + 1 < workers ? sliceStart(w + 1) : count;
+        if (begin < end) threads.emplace_back([&work, begin, end] { work(begin, end); });
+    }
+    work(0, sliceStart(1));
+    for (auto& thread : threads) thread.join();
+}
+
+// answers[i] = solve(queries[i]) for every query; `answers` must already have the same size
+template <class Query, class Answer, class Solve>
+void answerInParallel(const std::vector<Query>& queries, std::vector<Answer>& answers, Solve solve) {
+    forEachSliceInParallel(queries.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) answers[i] = solve(queries[i]);
+    }, answers.data());
+}
@@ -0,0 +1,252 @@
+/*
+    PERSISTENT SEGMENT TREE (VERSIONED)
+    ===================================
+    A segment tree that keeps every earlier state of the array queryable. Each point update
+    creates a new version; query(version, l, r) answers a range query on the array exactly
+    as it was in that version. Keeping a full copy of the tree per version would cost O(n)
+    time and memory per update, this costs O(log n) for both.
+
+KEY CONCEPTS:
+    1. Path Copying - An update only changes the nodes on the path from the root to one leaf.
+       Instead of modifying them, it creates copies of those ⌈log2 n⌉ + 1 nodes; every copy
+       points to its one new child and shares the other child with the old version.
+       The new root is the new version, and the old root still describes the old array.
+    2. Arena - Nodes are not in heap layout (children are not at 2i+1 and 2i+2, since
+       subtrees are shared), so each node stores the indices of its children. All nodes live
+       in one vector and refer to each other with 32-bit indices instead of pointers: a
+       node is 16 bytes for long long values, and there is no allocation per node.
+    3. Topological Order - A node is always created after its children, so every child has a
+       smaller arena index than its parent. Garbage collection relies on this.
+
+ALGORITHMS:
+
+    Point Update (index, value) on version v:
+      1. Leaf         → create a leaf with the new value
+      2. Internal     → recurse into the child that contains index, then create a node with
+                        the new child, the other (shared) child and their combined value
+      The root created last becomes the next version.
+
+    Range Query [queryStart, queryEnd] on version v:
+      The usual three cases of SegmentTree (Segment_Tree.h), starting at the root of v.
+
+    Version Garbage Collection:
+      Versions that are no longer needed are released (releaseVersion / releaseVersionsBefore).
+      Their nodes are not freed one by one, since most of them are shared with other
+      versions. Instead collectGarbage() compacts the arena:
+        • Mark: mark the roots of the live versions, then walk the arena from the highest index
+          down; every marked node marks its children. Children have smaller indices, so one
+          pass marks everything reachable, without a stack.
+        • Compact: move the marked nodes to the front, keeping their order, and rewrite the
+          child indices (children were moved before their parents, so their new indices
+          are already known). The order is kept, so the arena stays topologically sorted.
+      updateValue() runs it automatically once the arena has grown to twice the size it had
+      after the previous collection and some version was released since, so the cost is
+      O(1) amortized per created node and the memory stays within twice the live nodes.
+
+    Time Complexity: O(n) build, O(log n) per update and query, O(arena size) per collection
+    Space Complexity: O(n + live versions × log n) nodes
+
+USAGE:
+    PersistentSegmentTree<SumMonoid<long long>> tree(array, size);    // Version 0
+    int version = tree.updateValue(index, newValue);                  // New version from the latest
+    int branch = tree.updateValue(oldVersion, index, newValue);        // New version from any version
+    long long now = tree.query(left, right);                          // Latest version
+    long long then = tree.query(oldVersion, left, right);
+    tree.releaseVersionsBefore(tree.latestVersion() - 1000);          // Keep the last 1000 versions
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "Monoids.h"
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class PersistentSegmentTree {
+    static const uint32_t RELEASED = UINT32_MAX;
+
+    struct Node {
+        T value;
+        uint32_t left, right;   // Arena indices of the children, unused in leaves
+    };
+
+    int n;
+    std::vector<Node> nodes;
+    // Root of every version still known; roots[i] belongs to version firstVersion + i
+    std::deque<uint32_t> roots;
+    int firstVersion = 0;
+    size_t liveNodesAfterCollection = 0;
+    bool releasedSinceCollection = false;
+
+    int getMidpoint(int startPoint, int endPoint) const {
+        return startPoint + (endPoint - startPoint) / 2;
+    }
+
+    uint32_t createNode(const T& value, uint32_t left, uint32_t right) {
+        nodes.push_back({value, left, right});
+        return nodes.size() - 1;
+    }
+
+    template <class U>
+    uint32_t buildSegTree(const U arr[], const int segmentStart, const int segmentEnd) {
+        // CASE 1: Segment size becomes one (leaf node)
+        if (segmentStart == segmentEnd) return createNode(T(arr[segmentStart]), 0, 0);
+
+        // CASE 2: Segment size >= 2 (internal node), created after both children
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        uint32_t left = buildSegTree(arr, segmentStart, mid);
+        uint32_t right = buildSegTree(arr, mid + 1, segmentEnd);
+        return createNode(Monoid::combine(nodes[left].value, nodes[right].value), left, right);
+    }
+
+    T rangeQuery(
+        const uint32_t nodeIndex,
+        const int segmentStart,
+        const int segmentEnd,
+        const int queryStart,
+        const int queryEnd
+    ) const {
+        // CASE 1: Segment completely lies inside the query range
+        if (queryStart <= segmentStart && segmentEnd <= queryEnd) return nodes[nodeIndex].value;
+
+        // CASE 2: Segment completely lies outside the query range
+        if (queryEnd < segmentStart || segmentEnd < queryStart) return Monoid::identity();
+
+        // CASE 3: Segment partially overlaps with the query range
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        return Monoid::combine(
+            rangeQuery(nodes[nodeIndex].left, segmentStart, mid, queryStart, queryEnd),
+            rangeQuery(nodes[nodeIndex].right, mid + 1, segmentEnd, queryStart, queryEnd));
+    }
+
+    // Returns the copy of nodeIndex's subtree with arr[updateIndex] = newValue
+    uint32_t pointUpdate(
+        const uint32_t nodeIndex,
+        const int segmentStart,
+        const int segmentEnd,
+        const int updateIndex,
+        const T& newValue
+    ) {
+        // CASE 1: Leaf node, the new leaf replaces it
+        if (segmentStart == segmentEnd) return createNode(newValue, 0, 0);
+
+        // CASE 2: Internal node, copy it with one new child
+        // (no references into `nodes` are held here: creating nodes may reallocate it)
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        uint32_t left = nodes[nodeIndex].left, right = nodes[nodeIndex].right;
+        if (updateIndex <= mid) left = pointUpdate(left, segmentStart, mid, updateIndex, newValue);
+        else right = pointUpdate(right, mid + 1, segmentEnd, updateIndex, newValue);
+        return createNode(Monoid::combine(nodes[left].value, nodes[right].value), left, right);
+    }
+
+    uint32_t rootOf(int version) const {
+        return roots[version - firstVersion];
+    }
+
+    // Drops released versions from the front, so a sliding window of versions uses bounded memory
+    void trimReleasedRoots() {
+        while (roots.size() > 1 && roots.front() == RELEASED) {
+            roots.pop_front();
+            ++firstVersion;
+        }
+    }
+
+public:
+    template <class U>
+    PersistentSegmentTree(const U arr[], int n) : n(n) {
+        nodes.reserve(2 * n);
+        roots.push_back(buildSegTree(arr, 0, n - 1));
+        liveNodesAfterCollection = nodes.size();
+    }
+
+    // Version 0 is the initial array, every update adds the next one
+    int latestVersion() const {
+        return firstVersion + roots.size() - 1;
+    }
+
+    // True if `version` can still be queried
+    bool hasVersion(int version) const {
+        return firstVersion <= version && version <= latestVersion() && rootOf(version) != RELEASED;
+    }
+
+    T query(int version, int rangeStart, int rangeEnd) const {
+        return rangeQuery(rootOf(version), 0, n - 1, rangeStart, rangeEnd);
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        return query(latestVersion(), rangeStart, rangeEnd);
+    }
+
+    // Creates a new version: `version` with arr[updateIndex] = newValue. Returns its number.
+    int updateValue(int version, int updateIndex, const T& newValue) {
+        roots.push_back(pointUpdate(rootOf(version), 0, n - 1, updateIndex, newValue));
+        if (releasedSinceCollection && nodes.size() >= 2 * liveNodesAfterCollection) collectGarbage();
+        return latestVersion();
+    }
+
+    int updateValue(int updateIndex, const T& newValue) {
+        return updateValue(latestVersion(), updateIndex, newValue);
+    }
+
+    // `version` will not be queried or updated anymore. The latest version cannot be released.
+    void releaseVersion(int version) {
+        if (!hasVersion(version) || version == latestVersion()) return;
+        roots[version - firstVersion] = RELEASED;
+        releasedSinceCollection = true;
+        trimReleasedRoots();
+    }
+
+    // Releases every version older than `version`
+    void releaseVersionsBefore(int version) {
+        for (int v = firstVersion; v < version && v < latestVersion(); ++v) {
+            roots[v - firstVersion] = RELEASED;
+            releasedSinceCollection = true;
+        }
+        trimReleasedRoots();
+    }
+
+    // Frees the nodes that no live version uses (see "Version Garbage Collection" above)
+    void collectGarbage() {
+        // Mark
+        std::vector<uint32_t> newIndex(nodes.size(), 0);
+        for (uint32_t root : roots) {
+            if (root != RELEASED) newIndex[root] = 1;
+        }
+        for (size_t i = nodes.size(); i-- > 0;) {
+            if (newIndex[i] && nodes[i].left != nodes[i].right) newIndex[nodes[i].left] = newIndex[nodes[i].right] = 1;
+        }
+
+        // Compact. Leaves (left == right == 0) keep their children: newIndex[0] may still be a
+        // mark, and with a single node there is no newIndex[1] to remap it to.
+        uint32_t live = 0;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (!newIndex[i]) continue;
+            Node node = nodes[i];
+            if (node.left != node.right) {
+                node.left = newIndex[node.left];
+                node.right = newIndex[node.right];
+            }
+            nodes[live] = node;
+            newIndex[i] = live++;
+        }
+        for (uint32_t& root : roots) {
+            if (root != RELEASED) root = newIndex[root];
+        }
+
+        nodes.resize(live);
+        liveNodesAfterCollection = live;
+        releasedSinceCollection = false;
+    }
+
+    // Nodes in the arena, including the ones waiting for the next collection
+    size_t nodeCount() const {
+        return nodes.size();
+    }
+
+    // Bytes used by the arena and the version table
+    size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(Node) + roots.size() * sizeof(uint32_t);
+    }
+};
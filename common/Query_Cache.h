@@ -0,0 +1,196 @@
+/*
+    VERSIONED QUERY RESULT CACHE
+    ============================
+    Wraps any range-query engine (FenwickTree, ShortRangeScan, IterativeSegmentTree, ...)
+    and remembers the answers of recent ranges. When the same [l, r] is asked again and no
+    update touched it in the meantime, the answer comes from the cache instead of a tree walk.
+    Meant for workloads that repeat a few hot ranges between sparse updates; on random
+    ranges it only adds a probe per query, so it is off unless asked for.
+
+HOW IT WORKS:
+    • Table - open addressing with linear probing over a power-of-two number of slots.
+      The key is (l, r); a lookup probes at most PROBE_LIMIT slots from the hashed one, so
+      it touches one or two cache lines. When all of them are taken, the new answer
+      replaces the one in the hashed slot: the cache never grows past its slot count.
+    • Block Versions - the array is split into blocks of 2^BLOCK_SHIFT elements, and every
+      block has a version counter that updateValue() increments. The counters live in a
+      FenwickTree, so the sum of the versions of the blocks under [l, r] is O(log(n / B)).
+      Counters only grow, so that sum is unchanged exactly when no block under the range
+      was updated. Each entry stores the sum from the time it was filled.
+    • Fast Path - each entry also stores the total number of updates at the time it was
+      last checked. If nothing was updated since, the entry is valid without summing block
+      versions; if the block versions still match, the entry is refreshed to the current
+      count. Updates outside the range therefore cost one version sum per entry, not a miss.
+    • Counters - hits() and misses() count cache lookups, to judge whether the cache pays
+      off for a given workload.
+
+    Time Complexity: O(1) per hit without updates in between, O(log(n / B)) per hit after
+                     unrelated updates, one engine query per miss; O(log(n / B)) extra per update
+    Space Complexity: O(slots + n / B) on top of the engine
+
+USAGE:
+    QueryCache<FenwickTree<long long>> tree(array, size, 1 << 16);    // 0 slots: no caching
+    long long result = tree.query(left, right);
+    tree.updateValue(index, newValue);
+    tree.queryBatch(ranges, answers);
+    size_t hits = tree.hits(), misses = tree.misses();
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Fenwick_Tree.h"
+
+template <class Engine>
+class QueryCache {
+    using T = decltype(std::declval<const Engine&>().query(0, 0));
+
+    static const int BLOCK_SHIFT = 9;
+    static const size_t PROBE_LIMIT = 4;
+
+    struct Entry {
+        int left = -1, right = -1;      // left == -1: empty slot
+        T value{};
+        uint64_t blockVersions;         // Sum of the versions of the blocks under [left, right]
+        uint64_t checkedAt;             // updateCount when the entry was last known to be valid
+    };
+
+    Engine engine;
+    FenwickTree<uint64_t> versions;
+    uint64_t updateCount = 0;
+    mutable std::vector<Entry> table;
+    size_t slotMask = 0;
+    mutable size_t hitCount = 0, missCount = 0;
+
+    // Scratch space of queryBatch() for the ranges the cache could not answer
+    mutable std::vector<std::pair<int, int>> missedRanges;
+    mutable std::vector<size_t> missedPositions;
+    mutable std::vector<T> missedAnswers;
+
+    static std::vector<uint64_t> zeroVersions(int n) {
+        return std::vector<uint64_t>((n >> BLOCK_SHIFT) + 1, 0);
+    }
+
+    static size_t roundUpToPowerOfTwo(size_t slots) {
+        size_t size = 1;
+        while (size < slots) size <<= 1;
+        return size;
+    }
+
+    size_t homeSlot(int rangeStart, int rangeEnd) const {
+        uint64_t key = (uint64_t(uint32_t(rangeStart)) << 32) | uint32_t(rangeEnd);
+        return (key * 0x9E3779B97F4A7C15ull >> 32) & slotMask;
+    }
+
+    uint64_t blockVersionSum(int rangeStart, int rangeEnd) const {
+        return versions.query(rangeStart >> BLOCK_SHIFT, rangeEnd >> BLOCK_SHIFT);
+    }
+
+    // The slot holding [rangeStart, rangeEnd], or nullptr
+    Entry* find(int rangeStart, int rangeEnd) const {
+        for (size_t probe = 0, slot = homeSlot(rangeStart, rangeEnd); probe < PROBE_LIMIT; ++probe, slot = (slot + 1) & slotMask) {
+            Entry& entry = table[slot];
+            if (entry.left == rangeStart && entry.right == rangeEnd) return &entry;
+            if (entry.left == -1) return nullptr;
+        }
+        return nullptr;
+    }
+
+    // Looks the range up; on a hit stores the answer in `value`
+    bool lookup(int rangeStart, int rangeEnd, T& value) const {
+        Entry* entry = find(rangeStart, rangeEnd);
+        if (entry != nullptr && entry->checkedAt != updateCount) {
+            if (entry->blockVersions == blockVersionSum(rangeStart, rangeEnd)) entry->checkedAt = updateCount;
+        }
+        if (entry == nullptr || entry->checkedAt != updateCount) {
+            ++missCount;
+            return false;
+        }
+        ++hitCount;
+        value = entry->value;
+        return true;
+    }
+
+    void store(int rangeStart, int rangeEnd, const T& value) const {
+        const size_t home = homeSlot(rangeStart, rangeEnd);
+        Entry* target = &table[home];
+        for (size_t probe = 0, slot = home; probe < PROBE_LIMIT; ++probe, slot = (slot + 1) & slotMask) {
+            Entry& entry = table[slot];
+            if (entry.left == -1 || (entry.left == rangeStart && entry.right == rangeEnd)) {
+                target = &entry;
+                break;
+            }
+        }
+        *target = {rangeStart, rangeEnd, value, blockVersionSum(rangeStart, rangeEnd), updateCount};
+    }
+
+public:
+    template <class U>
+    QueryCache(const U arr[], int n, size_t slots)
+        : engine(arr, n), versions(zeroVersions(n).data(), (n >> BLOCK_SHIFT) + 1) {
+        if (slots == 0) return;
+        table.resize(roundUpToPowerOfTwo(slots));
+        slotMask = table.size() - 1;
+    }
+
+    bool enabled() const {
+        return !table.empty();
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        if (!enabled()) return engine.query(rangeStart, rangeEnd);
+        T value;
+        if (lookup(rangeStart, rangeEnd, value)) return value;
+        value = engine.query(rangeStart, rangeEnd);
+        store(rangeStart, rangeEnd, value);
+        return value;
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second); the misses go to the engine's
+    // queryBatch() together
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        if (!enabled()) {
+            engine.queryBatch(ranges, out);
+            return;
+        }
+        missedRanges.clear();
+        missedPositions.clear();
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (lookup(ranges[i].first, ranges[i].second, out[i])) continue;
+            missedRanges.push_back(ranges[i]);
+            missedPositions.push_back(i);
+        }
+        if (missedRanges.empty()) return;
+
+        missedAnswers.resize(missedRanges.size());
+        engine.queryBatch(missedRanges, missedAnswers);
+        for (size_t j = 0; j < missedRanges.size(); ++j) {
+            out[missedPositions[j]] = missedAnswers[j];
+            store(missedRanges[j].first, missedRanges[j].second, missedAnswers[j]);
+        }
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        engine.updateValue(updateIndex, newValue);
+        if (!enabled()) return;
+        versions.addValue(updateIndex >> BLOCK_SHIFT, 1);
+        ++updateCount;
+    }
+
+    size_t hits() const {
+        return hitCount;
+    }
+
+    size_t misses() const {
+        return missCount;
+    }
+
+    // Bytes used by the engine, the table and the block versions
+    size_t memoryUsage() const {
+        return engine.memoryUsage() + table.capacity() * sizeof(Entry) + versions.memoryUsage();
+    }
+};
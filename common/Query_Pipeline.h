@@ -0,0 +1,105 @@
+/*
+    THREE-STAGE QUERY PIPELINE
+    ==========================
+    Runs a stream of update/query records through three stages that overlap in time:
+      1. parse    - decode the next record from the input
+      2. compute  - apply updates and answer queries, strictly in input order
+      3. format   - print one answer
+    In the usual `while (Q--)` loop one core does all three one after another. Here each
+    stage has its own thread, so while the tree works on record i, record i + 1000 is
+    already being parsed and the answer of record i - 1000 being printed.
+
+HOW IT WORKS:
+    • parser thread  --SpscRing<Record>-->  calling thread (compute)  --SpscRing<Answer>-->  formatter thread
+    • Every ring has exactly one producer and one consumer, and both are FIFO, so records
+      are computed in input order and answers are printed in the order they were produced.
+      The output is byte for byte the same as the one of the serial loop.
+    • The compute stage takes whatever records are ready (at most PIPELINE_CHUNK) and gets
+      them as one span, so it can still batch consecutive queries (queryBatch()) as long as
+      it answers them before the end of the span.
+    • Only the parser thread may touch the input and only the formatter thread the output
+      while the pipeline runs; compute hands its answers to answers.push(...).
+    • With fewer than 3 cores the stages would only take turns on the same core and pay
+      for the hand-offs, so they run one chunk at a time on the calling thread instead:
+      parse a chunk, compute it, format its answers. The stage functions are the same.
+
+USAGE:
+    runQueryPipeline<long long>(Q,
+        [] { Query query; input >> query.type >> query.a >> query.b; return query; },
+        [&](span<const Query> records, auto& answers) { ... answers.push(sum); ... },
+        [](long long answer) { output << answer << '\n'; });
+    output.flush();
+    Build with -pthread.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Spsc_Ring.h"
+
+const size_t PIPELINE_CHUNK = 1024;
+const size_t PIPELINE_RING_CAPACITY = 1 << 14;
+
+// One thread per stage only pays off with one core per stage
+inline bool pipelineThreadsAvailable() {
+    return std::thread::hardware_concurrency() >= 3;
+}
+
+// Collects the answers of one chunk when the stages run on the calling thread
+template <class Answer>
+struct AnswerBuffer {
+    std::vector<Answer> answers;
+
+    void push(const Answer& answer) {
+        answers.push_back(answer);
+    }
+};
+
+// Parses `count` records with parse(), hands them in order to compute(span<const Record>, answers)
+// and every answer pushed there to format(answer)
+template <class Answer, class Parse, class Compute, class Format>
+void runQueryPipeline(size_t count, Parse parse, Compute compute, Format format,
+                      bool useThreads = pipelineThreadsAvailable()) {
+    using Record = std::invoke_result_t<Parse&>;
+    std::vector<Record> records(PIPELINE_CHUNK);
+
+    if (!useThreads) {
+        AnswerBuffer<Answer> buffer;
+        for (size_t done = 0; done < count;) {
+            const size_t size = std::min(PIPELINE_CHUNK, count - done);
+            for (size_t i = 0; i < size; ++i) records[i] = parse();
+            compute(std::span<const Record>(records.data(), size), buffer);
+            for (const Answer& answer : buffer.answers) format(answer);
+            buffer.answers.clear();
+            done += size;
+        }
+        return;
+    }
+
+    SpscRing<Record> recordRing(PIPELINE_RING_CAPACITY);
+    SpscRing<Answer> answerRing(PIPELINE_RING_CAPACITY);
+
+    std::thread parser([&] {
+        for (size_t i = 0; i < count; ++i) recordRing.push(parse());
+        recordRing.close();
+    });
+    std::thread formatter([&] {
+        std::vector<Answer> answers(PIPELINE_CHUNK);
+        while (size_t size = answerRing.pop(answers)) {
+            for (size_t i = 0; i < size; ++i) format(answers[i]);
+        }
+    });
+
+    while (size_t size = recordRing.pop(records)) {
+        compute(std::span<const Record>(records.data(), size), answerRing);
+    }
+    answerRing.close();
+
+    parser.join();
+    formatter.join();
+}
@@ -0,0 +1,467 @@
+/*
+    SEGMENT TREE DATA STRUCTURE
+    ============================
+    This is a versatile implementation of Segment Tree that works with any monoid (see Monoids.h).
+    Segment Tree offers efficient point updates and range queries with O(log n) time complexity for both.
+
+    The operation is a template parameter, so SUM/MIN/MAX (and user-defined monoids like
+    gcd, xor or affine composition) are specialized at compile time. There is no switch
+    on the hot path and combine() gets inlined into the recursion.
+
+KEY CONCEPTS:
+    1. Segment Tree - Binary tree where each node represents a segment (range) of the array
+    2. Recursion - Used for building tree, querying, and updating
+    3. Identity Elements - Neutral values (0 for SUM, LLONG_MIN for MAX, LLONG_MAX for MIN)
+
+SEGMENT TREE STRUCTURE:
+    • Array-based representation where node at index i has:
+      - Left child at index: 2*i + 1
+      - Right child at index: 2*i + 2
+    • Where a node with heap index i is stored in memory is decided by the Layout template
+      parameter (see Node_Layouts.h). The default HeapLayout stores it at index i;
+      BlockedLayout packs every 3 levels of a path into one cache line
+    • Each node stores the result (sum/min/max) for its corresponding segment
+    • Leaf nodes represent individual array elements
+    • Internal nodes represent combined results of their children
+
+ALGORITHMS:
+
+    STEP 1: Build Segment Tree
+    ---------------------------
+    Recursively builds the tree in a bottom-up manner:
+
+    Base Case:
+      • When segment contains only one element (leaf node), store that element's value
+
+    Recursive Case:
+      • Split segment into two halves at midpoint
+      • Recursively build left subtree for range [start, mid]
+      • Recursively build right subtree for range [mid+1, end]
+      • Combine results from both children using the operation (sum/min/max)
+      • Store combined result in current node
+
+    Example for array [3, 1, 4, 2, 5]:
+      - Root stores result for [0, 4]
+      - Left child stores result for [0, 2]
+      - Right child stores result for [3, 4]
+
+    Time Complexity: O(n) - visits each array element once
+    Space Complexity: O(2^(ceil(log2 n) + 1)) ≤ O(4n) - segment tree array size
+
+    STEP 2: Range Query
+    -------------------
+    Finds the result for a query range [queryStart, queryEnd] by traversing the tree:
+
+    Three Cases:
+      1. Complete Overlap: Current segment lies completely inside query range
+         → Return the stored value at this node (no need to go deeper)
+
+      2. No Overlap: Current segment lies completely outside query range
+         → Return neutral value (0 for SUM, LLONG_MIN for MAX, LLONG_MAX for MIN)
+
+      3. Partial Overlap: Current segment partially overlaps with query range
+         → Recursively query both left and right children
+         → Combine results from both children using the operation
+
+    Example: Query range [1, 3] in segment tree for [3, 1, 4, 2, 5]
+      - Starts at root [0, 4] - partial overlap, splits
+      - Checks left [0, 2] - partial overlap, splits further
+      - Checks right [3, 4] - partial overlap, splits further
+      - Combines only the relevant segments
+
+    Time Complexity: O(log n) - at most visits O(log n) nodes per level
+    Space Complexity: O(log n) - recursion stack depth
+
+    STEP 3: Point Update
+    --------------------
+    Updates a single element and propagates changes up the tree:
+
+    Process:
+      1. Traverse down to the leaf node containing the update index
+      2. Update the leaf node with new value
+      3. Backtrack up the tree, recalculating each ancestor node
+         by combining values from its left and right children
+
+    Three Cases:
+      1. Out of Range: Current segment doesn't contain the update index
+         → Return immediately, no changes needed
+
+      2. Leaf Node: Reached the exact element to update
+         → Update the value in segment tree
+
+      3. Internal Node: Segment contains the update index but not a leaf
+         → Recursively update appropriate child (left or right)
+         → Recalculate current node by combining updated children
+
+    Example: Update index 2 to value 7 in [3, 1, 4, 2, 5]
+      - Traverses to leaf representing index 2
+      - Updates leaf node
+      - Recalculates parent covering [2, 2]
+      - Recalculates ancestor covering [0, 2]
+      - Recalculates root covering [0, 4]
+
+    Time Complexity: O(log n) - traverses height of tree twice (down and up)
+    Space Complexity: O(log n) - recursion stack depth
+
+    STEP 4: Batched Point Updates
+    -----------------------------
+    k updates applied one by one recompute the root k times, its children about k/2 times
+    each, and so on. applyUpdates() recomputes every affected node only once:
+
+    Process:
+      1. Stable-sort the updates by index (for repeated indices the last one must win)
+      2. One descent from the root, like Point Update, but carrying the slice of sorted
+         updates that falls into the current segment:
+         → Empty slice: nothing below changes, return immediately
+         → Leaf node: take the value of the last update in the slice
+         → Internal node: split the slice at mid with a binary search, descend into the
+           children that received updates, then recalculate the current node once
+      3. When k ≥ n / FULL_REBUILD_DIVISOR the sort is no longer worth it: the new values
+         are scattered into an array of size n and the whole tree is rebuilt from its
+         leaves in O(n)
+
+    Time Complexity: O(k log k + k log(n/k)), at most O(n) nodes visited
+    Space Complexity: O(k) for the sorted copy, O(n) in the full rebuild
+
+    STEP 5: Tree-Descent Searches
+    -----------------------------
+    Binary searching over query() costs O(log n) queries of O(log n) each. When the predicate
+    is monotone, the tree can be searched directly instead:
+
+    findFirst(l, pred): smallest r ≥ l with pred(combine(arr[l..r])) true, or n if none.
+    pred must stay true once it became true as r grows (e.g. "sum ≥ k" for non-negative
+    values, "min < x", "max > x").
+      • Visit the nodes of [l, n - 1] from left to right, keeping `acc`, the combination of
+        everything to the left of the current node
+      • Node fully right of l: if pred(combine(acc, node)) is false, the answer is not in
+        it → fold it into acc and skip it. Otherwise the answer is inside → descend into
+        it, left child first. Only one node is descended into this way.
+      • Node partially left of l: descend into both children, left first
+    findLast(r, pred) is the mirror image: largest l ≤ r with pred(combine(arr[l..r])) true,
+    or -1, visiting nodes from right to left.
+
+    Built on top of them:
+      • lowerBoundPrefixSum(k) - first index whose prefix sum is ≥ k (SUM, values ≥ 0), n if none
+      • firstLess(a, b, x)     - first index in [a, b] with value < x (MIN), -1 if none
+      • firstGreater(a, b, x)  - first index in [a, b] with value > x (MAX), -1 if none
+
+    Time Complexity: O(log n) - at most two root-to-leaf paths plus the nodes skipped beside them
+    Space Complexity: O(log n) - recursion stack depth
+
+USAGE:
+    SegmentTree<SumMonoid<long long>> tree(array, size);   // or MinMonoid, MaxMonoid, ...
+    long long result = tree.query(left, right);             // Range query
+    tree.queryBatch(ranges, answers);                       // span<const pair<int, int>>, span<long long>
+    tree.updateValue(index, newValue);                      // Point update
+    tree.applyUpdates(updates);                             // span<const pair<int, long long>>, in order
+    int r = tree.findFirst(l, [&](long long sum) { return sum >= k; });    // Smallest r, n if none
+    int l = tree.findLast(r, [&](long long sum) { return sum >= k; });     // Largest l, -1 if none
+    int i = tree.lowerBoundPrefixSum(k);                    // SUM tree
+    int j = minTree.firstLess(a, b, x);                     // MIN tree; maxTree.firstGreater(a, b, x)
+
+    SegmentTree<MinMonoid<long long>, long long, BlockedLayout<3>> blocked(array, size);
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+#include "Node_Layouts.h"
+
+template <class Monoid, class T = typename Monoid::ValueType, class Layout = HeapLayout>
+class SegmentTree {
+    using Update = std::pair<int, T>;
+    static const int FULL_REBUILD_DIVISOR = 8;
+
+    int n;
+    Layout layout;
+    std::vector<T, CacheLineAllocator<T>> segTree;
+
+    // Number of levels of the tree built by buildSegTree(): depth ceil(log2 n) + 1
+    static int treeHeight(int n) {
+        int height = 1;
+        while ((1 << (height - 1)) < n) ++height;
+        return height;
+    }
+
+    // Position in segTree of the left (side 0) or right (side 1) child of a node
+    size_t childIndex(const size_t segmentIndex, const int depth, const int side) const {
+        return layout.child(segmentIndex, depth, side);
+    }
+
+    int getMidpoint(int startPoint, int endPoint) const {
+        return startPoint + (endPoint - startPoint) / 2;
+    }
+
+    template <class U>
+    T buildSegTree(
+        const U arr[],
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth
+    ) {
+        // CASE 1: Segment size becomes one (leaf node)
+        if (segmentEnd == segmentStart) {
+            return segTree[segmentIndex] = T(arr[segmentEnd]);
+        }
+
+        // CASE 2: Segment size >= 2 (internal node)
+        int mid = getMidpoint(segmentStart, segmentEnd);
+
+        T leftValue  = buildSegTree(arr, segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1);
+        T rightValue = buildSegTree(arr, mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1);
+
+        return segTree[segmentIndex] = Monoid::combine(leftValue, rightValue);
+    }
+
+    T rangeQuery(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const int queryStart,
+        const int queryEnd
+    ) const {
+        // CASE 1: Segment completely lies inside the query range
+        if (queryStart <= segmentStart && segmentEnd <= queryEnd) {
+            return segTree[segmentIndex];
+        }
+
+        // CASE 2: Segment completely lies outside the query range
+        if (queryEnd < segmentStart || segmentEnd < queryStart) {
+            return Monoid::identity();
+        }
+
+        // CASE 3: Segment partially overlaps with the query range
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        T leftValue  = rangeQuery(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, queryStart, queryEnd);
+        T rightValue = rangeQuery(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, queryStart, queryEnd);
+
+        return Monoid::combine(leftValue, rightValue);
+    }
+
+    void pointUpdate(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const int updateIndex,
+        const T& newValue
+    ) {
+        // CASE 1: Segment does not contain the index whose value is being updated
+        if (segmentStart > updateIndex || updateIndex > segmentEnd) {
+            return;
+        }
+
+        // CASE 2: Reached the leaf node containing the update index
+        if (segmentEnd == segmentStart) {
+            segTree[segmentIndex] = newValue;
+            return;
+        }
+
+        // CASE 3: Internal node - recursively update children and recalculate
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        pointUpdate(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, updateIndex, newValue);
+        pointUpdate(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, updateIndex, newValue);
+
+        // Recalculate current node's value based on updated children
+        T leftValue   = segTree[childIndex(segmentIndex, depth, 0)];
+        T rightValue  = segTree[childIndex(segmentIndex, depth, 1)];
+        segTree[segmentIndex] = Monoid::combine(leftValue, rightValue);
+    }
+
+    // `first` .. `last` are the updates inside this segment, sorted by index (not empty)
+    void batchUpdate(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const Update* first,
+        const Update* last
+    ) {
+        // CASE 1: Leaf node - the last update of this index wins
+        if (segmentEnd == segmentStart) {
+            segTree[segmentIndex] = last[-1].second;
+            return;
+        }
+
+        // CASE 2: Internal node - only descend into children that received updates
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        const Update* split = std::partition_point(first, last, [mid](const Update& update) { return update.first <= mid; });
+        if (first != split) batchUpdate(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, first, split);
+        if (split != last) batchUpdate(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, split, last);
+
+        segTree[segmentIndex] = Monoid::combine(segTree[childIndex(segmentIndex, depth, 0)],
+                                                segTree[childIndex(segmentIndex, depth, 1)]);
+    }
+
+    // Rebuilds every node; leaves with updated[i] set take newValues[i], the others keep their value
+    void rebuild(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const std::vector<char>& updated,
+        const std::vector<T>& newValues
+    ) {
+        if (segmentEnd == segmentStart) {
+            if (updated[segmentStart]) segTree[segmentIndex] = newValues[segmentStart];
+            return;
+        }
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        rebuild(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, updated, newValues);
+        rebuild(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, updated, newValues);
+        segTree[segmentIndex] = Monoid::combine(segTree[childIndex(segmentIndex, depth, 0)],
+                                                segTree[childIndex(segmentIndex, depth, 1)]);
+    }
+
+    // First index ≥ rangeStart where pred(acc + arr[rangeStart..index]) holds inside this
+    // segment, or -1; folds the segments it skips into acc
+    template <class Predicate>
+    int descendFirst(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const int rangeStart,
+        const Predicate& pred,
+        T& acc
+    ) const {
+        // CASE 1: Segment completely lies left of the search start
+        if (segmentEnd < rangeStart) return -1;
+
+        // CASE 2: Segment completely lies inside the searched part and the answer is not in it
+        if (rangeStart <= segmentStart) {
+            T combined = Monoid::combine(acc, segTree[segmentIndex]);
+            if (!pred(combined)) {
+                acc = combined;
+                return -1;
+            }
+            if (segmentStart == segmentEnd) return segmentStart;
+        }
+
+        // CASE 3: The answer is in this segment, or it is only partly searched
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        int found = descendFirst(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, rangeStart, pred, acc);
+        if (found != -1) return found;
+        return descendFirst(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, rangeStart, pred, acc);
+    }
+
+    // Mirror image of descendFirst(): last index ≤ rangeEnd where pred(arr[index..rangeEnd] + acc) holds
+    template <class Predicate>
+    int descendLast(
+        const int segmentStart,
+        const int segmentEnd,
+        const size_t segmentIndex,
+        const int depth,
+        const int rangeEnd,
+        const Predicate& pred,
+        T& acc
+    ) const {
+        // CASE 1: Segment completely lies right of the search start
+        if (segmentStart > rangeEnd) return -1;
+
+        // CASE 2: Segment completely lies inside the searched part and the answer is not in it
+        if (segmentEnd <= rangeEnd) {
+            T combined = Monoid::combine(segTree[segmentIndex], acc);
+            if (!pred(combined)) {
+                acc = combined;
+                return -1;
+            }
+            if (segmentStart == segmentEnd) return segmentStart;
+        }
+
+        // CASE 3: The answer is in this segment, or it is only partly searched
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        int found = descendLast(mid+1, segmentEnd, childIndex(segmentIndex, depth, 1), depth + 1, rangeEnd, pred, acc);
+        if (found != -1) return found;
+        return descendLast(segmentStart, mid, childIndex(segmentIndex, depth, 0), depth + 1, rangeEnd, pred, acc);
+    }
+
+public:
+    template <class U>
+    SegmentTree(const U arr[], int n) : n(n), layout(treeHeight(n)) {
+        segTree.resize(layout.size(), Monoid::identity());
+        buildSegTree(arr, 0, n - 1, layout.position(0, 0), 0);
+    }
+
+    T query(const int rangeStart, const int rangeEnd) const {
+        return rangeQuery(0, n - 1, layout.position(0, 0), 0, rangeStart, rangeEnd);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second). A plain loop, so the tree can stand in
+    // for IterativeSegmentTree and WideSegmentTree: a recursive walk has no fixed number of
+    // steps to run several of in lock-step the way their queryBatch() does.
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        for (size_t i = 0; i < ranges.size(); ++i) out[i] = query(ranges[i].first, ranges[i].second);
+    }
+
+    void updateValue(const int updateIndex, const T& newValue) {
+        pointUpdate(0, n - 1, layout.position(0, 0), 0, updateIndex, newValue);
+    }
+
+    // Same result as calling updateValue() for every (index, value) in order
+    void applyUpdates(std::span<const Update> updates) {
+        if (updates.empty()) return;
+
+        if (updates.size() * FULL_REBUILD_DIVISOR >= (size_t)n) {
+            std::vector<char> updated(n, false);
+            std::vector<T> newValues(n);
+            for (const auto& [index, value] : updates) {
+                updated[index] = true;
+                newValues[index] = value;
+            }
+            rebuild(0, n - 1, layout.position(0, 0), 0, updated, newValues);
+            return;
+        }
+
+        std::vector<Update> sorted(updates.begin(), updates.end());
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const Update& a, const Update& b) { return a.first < b.first; });
+        batchUpdate(0, n - 1, layout.position(0, 0), 0, sorted.data(), sorted.data() + sorted.size());
+    }
+
+    // Smallest r ≥ rangeStart with pred(query(rangeStart, r)), or n. pred must be monotone:
+    // once true for some r, true for every larger r.
+    template <class Predicate>
+    int findFirst(int rangeStart, const Predicate& pred) const {
+        T acc = Monoid::identity();
+        int found = descendFirst(0, n - 1, layout.position(0, 0), 0, rangeStart, pred, acc);
+        return found == -1 ? n : found;
+    }
+
+    // Largest l ≤ rangeEnd with pred(query(l, rangeEnd)), or -1. pred must be monotone:
+    // once true for some l, true for every smaller l.
+    template <class Predicate>
+    int findLast(int rangeEnd, const Predicate& pred) const {
+        T acc = Monoid::identity();
+        return descendLast(0, n - 1, layout.position(0, 0), 0, rangeEnd, pred, acc);
+    }
+
+    // SUM tree over non-negative values: first index whose prefix sum is ≥ target, or n
+    int lowerBoundPrefixSum(const T& target) const {
+        return findFirst(0, [&](const T& sum) { return !(sum < target); });
+    }
+
+    // MIN tree: first index in [rangeStart, rangeEnd] with a value < bound, or -1
+    int firstLess(int rangeStart, int rangeEnd, const T& bound) const {
+        int found = findFirst(rangeStart, [&](const T& minimum) { return minimum < bound; });
+        return found <= rangeEnd ? found : -1;
+    }
+
+    // MAX tree: first index in [rangeStart, rangeEnd] with a value > bound, or -1
+    int firstGreater(int rangeStart, int rangeEnd, const T& bound) const {
+        int found = findFirst(rangeStart, [&](const T& maximum) { return bound < maximum; });
+        return found <= rangeEnd ? found : -1;
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return segTree.capacity() * sizeof(T);
+    }
+};
@@ -0,0 +1,330 @@
+/*
+    SEGMENT TREE BEATS (RANGE CHMIN / CHMAX)
+    ========================================
+    A lazy segment tree that also supports clamping a range, which ordinary lazy tags cannot
+    express (min(x, arr[i]) over a segment does not change its sum in a way the old sum and
+    the segment length can tell):
+      • rangeChmin(l, r, x)   - arr[i] = min(arr[i], x)   for every i in [l, r]
+      • rangeChmax(l, r, x)   - arr[i] = max(arr[i], x)
+      • rangeAdd(l, r, x)     - arr[i] += x
+      • updateValue(i, x)     - arr[i] = x
+      • querySum / queryMin / queryMax over [l, r]
+
+KEY CONCEPTS:
+    1. Second Maximum - Every node stores its maximum, how many elements are equal to it, and
+       the largest value strictly below it (max2). A chmin with max2 < x < max only lowers the
+       elements equal to the maximum, so the node can be updated in O(1):
+           sum -= (max - x) * maxCount,  max = x
+       and the clamp is passed to the children later, like a lazy tag.
+    2. The same on the other side: min, minCount and the second minimum (min2) for chmax.
+    3. Break / Tag / Recurse - A clamp stops at a node where it changes nothing (max ≤ x),
+       tags a node where only the maximum changes (max2 < x), and otherwise recurses.
+       Every recursion past a tag condition merges at least two distinct values of the
+       node into one, which is what pays for it in the amortized analysis.
+    4. Implicit Tags - There is no separate chmin/chmax tag. A child whose max is above its
+       parent's max must have been clamped, so pushDown() clamps it to the parent's max
+       (and likewise for min). Only range add needs an explicit tag.
+
+ALGORITHMS:
+
+    Range Chmin [l, r] with x:
+      1. No overlap, or max ≤ x                → return
+      2. Complete overlap and max2 < x         → lower the maximum of this node, return
+      3. Otherwise                             → push down, recurse into both children,
+                                                 recalculate the node from its children
+    Range Chmax is the mirror image. Range Add and the queries are the usual lazy tree.
+
+    Lowering the maximum also has to fix the min side when they meet: if all elements of the
+    node are equal (max == min), the min drops too; if the max is the second minimum, so does
+    min2. Chmax does the same for max and max2.
+
+    Time Complexity: O(n) build, O(log n) per query, amortized O(log² n) per update when range
+                     adds are mixed in (O(log n) amortized with only chmin / chmax)
+    Space Complexity: O(4n) nodes of 8 words each
+
+USAGE:
+    SegmentTreeBeats<long long> tree(array, size);
+    tree.rangeChmin(left, right, x);        // Clamp to at most x
+    tree.rangeChmax(left, right, x);        // Clamp to at least x
+    tree.rangeAdd(left, right, x);
+    long long sum = tree.querySum(left, right);
+    long long low = tree.queryMin(left, right), high = tree.queryMax(left, right);
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+template <class T = long long>
+class SegmentTreeBeats {
+    static constexpr T NEG_INF = std::numeric_limits<T>::lowest();
+    static constexpr T POS_INF = std::numeric_limits<T>::max();
+
+    struct Node {
+        T sum;
+        T max, secondMax;       // secondMax: largest value < max, NEG_INF if none
+        T min, secondMin;       // secondMin: smallest value > min, POS_INF if none
+        int maxCount, minCount;
+        T pendingAdd;           // Added to this node, not yet to its children
+    };
+
+    int n;
+    std::vector<Node> segTree;
+
+    int getMidpoint(int startPoint, int endPoint) const {
+        return startPoint + (endPoint - startPoint) / 2;
+    }
+
+    void setLeaf(Node& node, const T& value) {
+        node = {value, value, NEG_INF, value, POS_INF, 1, 1, T(0)};
+    }
+
+    void pull(const int segmentIndex) {
+        Node& node = segTree[segmentIndex];
+        const Node& left = segTree[(segmentIndex << 1) + 1];
+        const Node& right = segTree[(segmentIndex << 1) + 2];
+        node.sum = left.sum + right.sum;
+
+        if (left.max == right.max) {
+            node.max = left.max;
+            node.maxCount = left.maxCount + right.maxCount;
+            node.secondMax = std::max(left.secondMax, right.secondMax);
+        } else {
+            const Node& larger = left.max > right.max ? left : right;
+            const Node& smaller = left.max > right.max ? right : left;
+            node.max = larger.max;
+            node.maxCount = larger.maxCount;
+            node.secondMax = std::max(larger.secondMax, smaller.max);
+        }
+
+        if (left.min == right.min) {
+            node.min = left.min;
+            node.minCount = left.minCount + right.minCount;
+            node.secondMin = std::min(left.secondMin, right.secondMin);
+        } else {
+            const Node& smaller = left.min < right.min ? left : right;
+            const Node& larger = left.min < right.min ? right : left;
+            node.min = smaller.min;
+            node.minCount = smaller.minCount;
+            node.secondMin = std::min(smaller.secondMin, larger.min);
+        }
+    }
+
+    void applyAdd(Node& node, const int segmentLength, const T& x) {
+        node.sum += x * T(segmentLength);
+        node.max += x;
+        node.min += x;
+        if (node.secondMax != NEG_INF) node.secondMax += x;
+        if (node.secondMin != POS_INF) node.secondMin += x;
+        node.pendingAdd += x;
+    }
+
+    // Lowers the maximum of a node to x, where secondMax < x < max
+    void applyChmin(Node& node, const T& x) {
+        node.sum -= (node.max - x) * T(node.maxCount);
+        if (node.min == node.max) node.min = x;                 // All elements were equal
+        else if (node.secondMin == node.max) node.secondMin = x;
+        node.max = x;
+    }
+
+    // Raises the minimum of a node to x, where min < x < secondMin
+    void applyChmax(Node& node, const T& x) {
+        node.sum += (x - node.min) * T(node.minCount);
+        if (node.max == node.min) node.max = x;
+        else if (node.secondMax == node.min) node.secondMax = x;
+        node.min = x;
+    }
+
+    // Hands the pending add and the implicit clamps of a node over to its two children
+    void pushDown(const int segmentStart, const int segmentEnd, const int segmentIndex) {
+        Node& node = segTree[segmentIndex];
+        Node& left = segTree[(segmentIndex << 1) + 1];
+        Node& right = segTree[(segmentIndex << 1) + 2];
+        int mid = getMidpoint(segmentStart, segmentEnd);
+
+        if (node.pendingAdd != T(0)) {
+            applyAdd(left, mid - segmentStart + 1, node.pendingAdd);
+            applyAdd(right, segmentEnd - mid, node.pendingAdd);
+            node.pendingAdd = T(0);
+        }
+        for (Node* child : {&left, &right}) {
+            if (child->max > node.max) applyChmin(*child, node.max);
+            if (child->min < node.min) applyChmax(*child, node.min);
+        }
+    }
+
+    template <class U>
+    void buildSegTree(const U arr[], const int segmentStart, const int segmentEnd, const int segmentIndex) {
+        // CASE 1: Segment size becomes one (leaf node)
+        if (segmentStart == segmentEnd) {
+            setLeaf(segTree[segmentIndex], T(arr[segmentStart]));
+            return;
+        }
+
+        // CASE 2: Segment size >= 2 (internal node)
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        buildSegTree(arr, segmentStart, mid, (segmentIndex << 1) + 1);
+        buildSegTree(arr, mid+1, segmentEnd, (segmentIndex << 1) + 2);
+        pull(segmentIndex);
+    }
+
+    void rangeChmin(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int updateStart,
+        const int updateEnd,
+        const T& x
+    ) {
+        // CASE 1 (break): No overlap, or nothing in the segment is above x
+        Node& node = segTree[segmentIndex];
+        if (updateEnd < segmentStart || segmentEnd < updateStart || node.max <= x) return;
+
+        // CASE 2 (tag): Complete overlap and only the maximum changes
+        if (updateStart <= segmentStart && segmentEnd <= updateEnd && node.secondMax < x) {
+            applyChmin(node, x);
+            return;
+        }
+
+        // CASE 3 (recurse)
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        rangeChmin(segmentStart, mid, (segmentIndex << 1) + 1, updateStart, updateEnd, x);
+        rangeChmin(mid+1, segmentEnd, (segmentIndex << 1) + 2, updateStart, updateEnd, x);
+        pull(segmentIndex);
+    }
+
+    void rangeChmax(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int updateStart,
+        const int updateEnd,
+        const T& x
+    ) {
+        // CASE 1 (break): No overlap, or nothing in the segment is below x
+        Node& node = segTree[segmentIndex];
+        if (updateEnd < segmentStart || segmentEnd < updateStart || node.min >= x) return;
+
+        // CASE 2 (tag): Complete overlap and only the minimum changes
+        if (updateStart <= segmentStart && segmentEnd <= updateEnd && node.secondMin > x) {
+            applyChmax(node, x);
+            return;
+        }
+
+        // CASE 3 (recurse)
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        rangeChmax(segmentStart, mid, (segmentIndex << 1) + 1, updateStart, updateEnd, x);
+        rangeChmax(mid+1, segmentEnd, (segmentIndex << 1) + 2, updateStart, updateEnd, x);
+        pull(segmentIndex);
+    }
+
+    void rangeAdd(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int updateStart,
+        const int updateEnd,
+        const T& x
+    ) {
+        if (updateEnd < segmentStart || segmentEnd < updateStart) return;
+        if (updateStart <= segmentStart && segmentEnd <= updateEnd) {
+            applyAdd(segTree[segmentIndex], segmentEnd - segmentStart + 1, x);
+            return;
+        }
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        rangeAdd(segmentStart, mid, (segmentIndex << 1) + 1, updateStart, updateEnd, x);
+        rangeAdd(mid+1, segmentEnd, (segmentIndex << 1) + 2, updateStart, updateEnd, x);
+        pull(segmentIndex);
+    }
+
+    void pointAssign(const int segmentStart, const int segmentEnd, const int segmentIndex, const int updateIndex, const T& x) {
+        if (segmentStart == segmentEnd) {
+            setLeaf(segTree[segmentIndex], x);
+            return;
+        }
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        if (updateIndex <= mid) pointAssign(segmentStart, mid, (segmentIndex << 1) + 1, updateIndex, x);
+        else pointAssign(mid+1, segmentEnd, (segmentIndex << 1) + 2, updateIndex, x);
+        pull(segmentIndex);
+    }
+
+    // Combines the nodes covering [queryStart, queryEnd] with `combine`, starting from `identity`;
+    // `field` picks the stored value of a node
+    template <class Field, class Combine>
+    T rangeQuery(
+        const int segmentStart,
+        const int segmentEnd,
+        const int segmentIndex,
+        const int queryStart,
+        const int queryEnd,
+        const T& identity,
+        Field field,
+        Combine combine
+    ) {
+        // CASE 1: Segment completely lies inside the query range
+        if (queryStart <= segmentStart && segmentEnd <= queryEnd) return field(segTree[segmentIndex]);
+
+        // CASE 2: Segment completely lies outside the query range
+        if (queryEnd < segmentStart || segmentEnd < queryStart) return identity;
+
+        // CASE 3: Segment partially overlaps with the query range
+        pushDown(segmentStart, segmentEnd, segmentIndex);
+        int mid = getMidpoint(segmentStart, segmentEnd);
+        return combine(
+            rangeQuery(segmentStart, mid, (segmentIndex << 1) + 1, queryStart, queryEnd, identity, field, combine),
+            rangeQuery(mid+1, segmentEnd, (segmentIndex << 1) + 2, queryStart, queryEnd, identity, field, combine));
+    }
+
+public:
+    template <class U>
+    SegmentTreeBeats(const U arr[], int n) : n(n), segTree(4 * n + 5) {
+        buildSegTree(arr, 0, n - 1, 0);
+    }
+
+    void rangeChmin(const int rangeStart, const int rangeEnd, const T& x) {
+        rangeChmin(0, n - 1, 0, rangeStart, rangeEnd, x);
+    }
+
+    void rangeChmax(const int rangeStart, const int rangeEnd, const T& x) {
+        rangeChmax(0, n - 1, 0, rangeStart, rangeEnd, x);
+    }
+
+    void rangeAdd(const int rangeStart, const int rangeEnd, const T& x) {
+        rangeAdd(0, n - 1, 0, rangeStart, rangeEnd, x);
+    }
+
+    void updateValue(const int updateIndex, const T& newValue) {
+        pointAssign(0, n - 1, 0, updateIndex, newValue);
+    }
+
+    // Not const: pushing tags down while descending changes the tree (but not its contents)
+    T querySum(const int rangeStart, const int rangeEnd) {
+        return rangeQuery(0, n - 1, 0, rangeStart, rangeEnd, T(0),
+                          [](const Node& node) { return node.sum; },
+                          [](const T& a, const T& b) { return a + b; });
+    }
+
+    T queryMin(const int rangeStart, const int rangeEnd) {
+        return rangeQuery(0, n - 1, 0, rangeStart, rangeEnd, POS_INF,
+                          [](const Node& node) { return node.min; },
+                          [](const T& a, const T& b) { return std::min(a, b); });
+    }
+
+    T queryMax(const int rangeStart, const int rangeEnd) {
+        return rangeQuery(0, n - 1, 0, rangeStart, rangeEnd, NEG_INF,
+                          [](const Node& node) { return node.max; },
+                          [](const T& a, const T& b) { return std::max(a, b); });
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return segTree.capacity() * sizeof(Node);
+    }
+};
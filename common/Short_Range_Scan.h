@@ -0,0 +1,278 @@
+/*
+    SHORT RANGE SCAN (HYBRID RANGE QUERIES)
+    =======================================
+    Wraps any range-query engine (FenwickTree, IterativeSegmentTree, WideSegmentTree, ...)
+    and answers short ranges by scanning the array instead of walking the tree.
+
+    A tree query costs O(log n) dependent steps no matter how short the range is, while
+    combining 20 consecutive values is a handful of vector instructions over one or two
+    cache lines. So below some length, scanning wins.
+
+HOW IT WORKS:
+    • A contiguous copy of the array (the leaves) is kept next to the engine, and point
+      updates go to both.
+    • Ranges with at most `threshold` elements are combined straight from the copy. For
+      SUM / MIN / MAX over long long this is an AVX2 loop (4 values per instruction, two
+      accumulators, a masked load for the last 0..3 values), picked at runtime like in
+      Wide_Segment_Tree.h. Everything else uses a plain loop.
+    • Longer ranges go to the engine. queryBatch() sends all of them to the engine's own
+      queryBatch() in one call, so batched engines keep their speed-up.
+
+CALIBRATION:
+    The crossover depends on the engine, the monoid, n and the machine, so the constructor
+    measures it on the real data:
+    • For the candidates 8, 16, 32, ... (up to MAX_THRESHOLD) the hybrid is timed against
+      the engine alone on random ranges of 1 .. 2 * candidate elements. Each candidate gets
+      CALIBRATION_ROUNDS rounds of fresh ranges and counts as a win when the median of the
+      hybrid / engine time ratios is below 1 - CALIBRATION_MARGIN. The search stops at the
+      first candidate that does not win.
+    • The result only replaces ShortRangeScanThreshold<Engine> (a default per engine
+      measured with benchmarks/Short_Range_Scan_Benchmark.cpp) if it also beats that
+      default by the margin, timed the same way. So a near tie keeps the default, and
+      repeated runs on one machine agree.
+    This takes a few milliseconds. Scanning and the engine return the same answers, so the
+    threshold only changes the speed. A constructor argument skips the measurement.
+
+USAGE:
+    ShortRangeScan<MinMonoid<long long>, WideSegmentTree<MinMonoid<long long>>> tree(array, size);
+    ShortRangeScan<SumMonoid<long long>, FenwickTree<long long>> sums(array, size, 32);  // Fixed threshold
+    long long result = tree.query(left, right);
+    tree.updateValue(index, newValue);
+    tree.queryBatch(ranges, answers);
+    int threshold = tree.scanThreshold();     // Chosen by the calibration
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+#include "Avx2_Lanes.h"
+
+// Combines `length` consecutive values. The generic version is a plain loop.
+template <class Monoid, class T>
+struct RangeScanKernel {
+    static constexpr bool HAS_AVX2 = false;
+
+    static T scan(const T* values, int length) {
+        T result = Monoid::identity();
+        for (int i = 0; i < length; ++i) result = Monoid::combine(result, values[i]);
+        return result;
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+template <class Monoid, class Lanes>
+struct LongLongScanKernel {
+    static constexpr bool HAS_AVX2 = true;
+
+    static long long scan(const long long* values, int length) {
+        long long result = Monoid::identity();
+        for (int i = 0; i < length; ++i) result = Monoid::combine(result, values[i]);
+        return result;
+    }
+
+    __attribute__((target("avx2"))) static long long scanAvx2(const long long* values, int length) {
+        const __m256i identity = _mm256_set1_epi64x(Monoid::identity());
+        __m256i first = identity, second = identity;
+        int i = 0;
+        // Two independent accumulators, so consecutive combines do not wait for each other
+        for (; i + 8 <= length; i += 8) {
+            first = Lanes::combine(first, _mm256_loadu_si256((const __m256i*)(values + i)));
+            second = Lanes::combine(second, _mm256_loadu_si256((const __m256i*)(values + i + 4)));
+        }
+        if (i + 4 <= length) {
+            first = Lanes::combine(first, _mm256_loadu_si256((const __m256i*)(values + i)));
+            i += 4;
+        }
+        // The last 0..3 values with a masked load instead of a scalar loop (no loop exit to
+        // mispredict). Masked-off lanes are not read and are replaced by the identity.
+        const __m256i keep = _mm256_cmpgt_epi64(_mm256_set1_epi64x(length - i), _mm256_setr_epi64x(0, 1, 2, 3));
+        const __m256i tail = _mm256_maskload_epi64((const long long*)(values + i), keep);
+        second = Lanes::combine(second, _mm256_blendv_epi8(identity, tail, keep));
+        return foldLanes<Lanes>(Lanes::combine(first, second));
+    }
+};
+
+template <> struct RangeScanKernel<SumMonoid<long long>, long long> : LongLongScanKernel<SumMonoid<long long>, SumLanes> {};
+template <> struct RangeScanKernel<MinMonoid<long long>, long long> : LongLongScanKernel<MinMonoid<long long>, MinLanes> {};
+template <> struct RangeScanKernel<MaxMonoid<long long>, long long> : LongLongScanKernel<MaxMonoid<long long>, MaxLanes> {};
+
+#endif
+
+template <class Monoid, class T> class WideSegmentTree;
+
+// Scan threshold the calibration of ShortRangeScan starts from and falls back to.
+// Measured on N = 2×10^5 random long long values: with ranges of 1..64 elements, scanning
+// up to 64 takes FenwickTree from 34 to 20 ns per query, IterativeSegmentTree from 58 to
+// 24 ns and SegmentTree from 348 to 23 ns; on long random ranges it costs at most 2 ns.
+template <class Engine>
+struct ShortRangeScanThreshold {
+    static const int value = 64;
+};
+
+// 6 levels for 2×10^5 values, each reduced with AVX2: 23 ns for ranges of 1..64 elements
+// without scanning, and no threshold is faster by more than the noise
+template <class Monoid, class T>
+struct ShortRangeScanThreshold<WideSegmentTree<Monoid, T>> {
+    static const int value = 0;
+};
+
+template <class Monoid, class Engine, class T = typename Monoid::ValueType>
+class ShortRangeScan {
+    using Kernel = RangeScanKernel<Monoid, T>;
+    static const int MAX_THRESHOLD = 4096;
+    static const int CALIBRATION_QUERIES = 1024;     // Per round and side
+    static const int CALIBRATION_ROUNDS = 5;
+    static constexpr double CALIBRATION_MARGIN = 0.05;
+
+    Engine engine;
+    std::vector<T> leaves;
+    int threshold;               // Ranges with at most this many elements are scanned
+    bool useAvx2 = false;
+
+    // Scratch space of queryBatch() for the ranges forwarded to the engine
+    mutable std::vector<std::pair<int, int>> longRanges;
+    mutable std::vector<T> longAnswers;
+
+    T scan(int rangeStart, int rangeEnd) const {
+        if constexpr (Kernel::HAS_AVX2) {
+            if (useAvx2) return Kernel::scanAvx2(leaves.data() + rangeStart, rangeEnd - rangeStart + 1);
+        }
+        return Kernel::scan(leaves.data() + rangeStart, rangeEnd - rangeStart + 1);
+    }
+
+    // Seconds taken by `answer` on all `ranges`. One run only: repeating it would time the
+    // ranges with warm caches, which flatters the scan (it reads more lines than a tree walk).
+    // The calibration draws fresh ranges for every round instead.
+    template <class Answer>
+    double timeRanges(const std::vector<std::pair<int, int>>& ranges, Answer answer) const {
+        T sink = Monoid::identity();
+        auto start = std::chrono::steady_clock::now();
+        for (auto [l, r] : ranges) sink = Monoid::combine(sink, answer(l, r));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // Keeps the compiler from dropping the loop
+        asm volatile("" : : "r"(&sink) : "memory");
+        return elapsed;
+    }
+
+    // Median over CALIBRATION_ROUNDS of time(first) / time(second) on random ranges of
+    // 1 .. maxLength elements. The two sides run on the same ranges, in alternating order.
+    // Round -1 is not counted: it warms up the caches, the branch predictors and the AVX2
+    // units, which made the first measurement after construction an outlier.
+    template <class First, class Second>
+    double medianTimeRatio(std::mt19937& rng, int maxLength, First first, Second second) const {
+        const int n = leaves.size();
+        std::vector<std::pair<int, int>> ranges(CALIBRATION_QUERIES);
+        double ratios[CALIBRATION_ROUNDS];
+        for (int round = -1; round < CALIBRATION_ROUNDS; ++round) {
+            for (auto& [l, r] : ranges) {
+                const int size = 1 + rng() % maxLength;
+                l = rng() % (n - size + 1);
+                r = l + size - 1;
+            }
+            double firstTime, secondTime;
+            if (round % 2 == 0) {
+                firstTime = timeRanges(ranges, first);
+                secondTime = timeRanges(ranges, second);
+            } else {
+                secondTime = timeRanges(ranges, second);
+                firstTime = timeRanges(ranges, first);
+            }
+            if (round >= 0) ratios[round] = firstTime / secondTime;
+        }
+        std::nth_element(ratios, ratios + CALIBRATION_ROUNDS / 2, ratios + CALIBRATION_ROUNDS);
+        return ratios[CALIBRATION_ROUNDS / 2];
+    }
+
+    // Time of the hybrid with threshold `candidate` / time of `other` (see medianTimeRatio)
+    template <class Other>
+    double hybridTimeRatio(std::mt19937& rng, int candidate, int maxLength, Other other) {
+        return medianTimeRatio(rng, maxLength,
+            [&](int l, int r) { return r - l < candidate ? scan(l, r) : engine.query(l, r); }, other);
+    }
+
+    // For every candidate threshold, the hybrid itself is timed against the engine on ranges of
+    // 1 .. 2 * candidate elements. About half of them are scanned and half go to the engine, so
+    // the time includes the mispredicted branch between the two paths, which eats most of the
+    // gain when the scan is only slightly faster than the engine.
+    void chooseThreshold() {
+        const int n = leaves.size();
+        const int fallback = ShortRangeScanThreshold<Engine>::value;
+        std::mt19937 rng(n);
+        auto engineQuery = [&](int l, int r) { return engine.query(l, r); };
+        threshold = fallback;
+        if (n < 16) return;
+
+        int measured = 0;
+        for (int candidate = 8; candidate <= MAX_THRESHOLD && 2 * candidate <= n; candidate *= 2) {
+            if (hybridTimeRatio(rng, candidate, 2 * candidate, engineQuery) >= 1 - CALIBRATION_MARGIN) break;
+            measured = candidate;
+        }
+        if (measured == fallback) return;
+
+        // Both thresholds on ranges up to twice the larger one
+        const int maxLength = std::min(n, 2 * std::max({measured, fallback, 8}));
+        auto fallbackQuery = [&](int l, int r) { return r - l < fallback ? scan(l, r) : engine.query(l, r); };
+        if (hybridTimeRatio(rng, measured, maxLength, fallbackQuery) < 1 - CALIBRATION_MARGIN) threshold = measured;
+    }
+
+public:
+    static const int CALIBRATE = -1;
+
+    // With a threshold, ranges of at most that many elements are scanned and no calibration runs
+    template <class U>
+    ShortRangeScan(const U arr[], int n, int threshold = CALIBRATE)
+        : engine(arr, n), leaves(arr, arr + n), threshold(threshold) {
+        if constexpr (Kernel::HAS_AVX2) useAvx2 = cpuSupportsAvx2();
+        if (threshold < 0) chooseThreshold();
+    }
+
+    // Measures the threshold again, e.g. after many updates (see "Calibration")
+    int calibrate() {
+        chooseThreshold();
+        return threshold;
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        if (rangeEnd - rangeStart < threshold) return scan(rangeStart, rangeEnd);
+        return engine.query(rangeStart, rangeEnd);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        longRanges.clear();
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            auto [l, r] = ranges[i];
+            if (r - l < threshold) out[i] = scan(l, r);
+            else longRanges.push_back({l, r});
+        }
+        if (longRanges.empty()) return;
+
+        longAnswers.resize(longRanges.size());
+        engine.queryBatch(longRanges, longAnswers);
+        for (size_t i = 0, next = 0; i < ranges.size(); ++i) {
+            if (ranges[i].second - ranges[i].first >= threshold) out[i] = longAnswers[next++];
+        }
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        leaves[updateIndex] = newValue;
+        engine.updateValue(updateIndex, newValue);
+    }
+
+    int scanThreshold() const {
+        return threshold;
+    }
+
+    // Bytes used by the engine and the copy of the leaves
+    size_t memoryUsage() const {
+        return engine.memoryUsage() + leaves.capacity() * sizeof(T);
+    }
+};
@@ -0,0 +1,168 @@
+/*
+    SIMD INTEGER PARSING KERNELS
+    ============================
+    Used by FastInput (Fast_Input.h) to turn a run of ASCII digits into a number without
+    the byte-at-a-time `x = x * 10 + digit` loop.
+
+HOW IT WORKS:
+
+    STEP 1: Find where the number ends
+    -----------------------------------
+    Load 32 bytes (AVX2) or 16 bytes (SSE4.1) starting at the first digit and compare all
+    of them against '0' and '9' at once. The resulting bitmask has a 1 for every byte that
+    is not a digit, so the number of digits is the count of trailing zeros of that mask.
+    When all 16 bytes are digits, the SSE4.1 kernel checks the next 16 the same way.
+
+    STEP 2: Convert up to 16 digits with multiply-adds
+    ---------------------------------------------------
+    Load 16 bytes, subtract '0' and shuffle them so the digits are right-aligned
+    (the unused lanes on the left become 0). Then:
+        maddubs  [d0 d1 d2 d3 ...] × [10 1 10 1 ...]      → 8 two-digit numbers
+        madd     [p0 p1 p2 p3 ...] × [100 1 100 1 ...]    → 4 four-digit numbers
+        packus                                             → squeeze back into 16-bit lanes
+        madd     [q0 q1 q2 q3 ...] × [10000 1 10000 1 ...] → 2 eight-digit numbers
+    and the result is high * 10^8 + low. Numbers with more than 16 digits parse their
+    leading digits with the scalar loop first.
+
+    STEP 3: Pick the kernel at runtime
+    -----------------------------------
+    detectIntegerParser() asks CPUID (through __builtin_cpu_supports) which instruction sets
+    are available. The kernels are compiled with target attributes, so the program itself
+    does not need -mavx2 and still runs on CPUs without it (falling back to the scalar loop).
+    SSE4.1 is preferred even where AVX2 exists. Both convert with the same 16-byte code, and
+    on the usual inputs (numbers of at most 10 digits) the 16-byte search is the cheaper
+    one: benchmarks/Fast_Input_Benchmark.cpp measures about 9.5 vs 10.3 ns per integer on
+    the range-query input. AVX2 is still ahead on 18-digit numbers (about 12 vs 13 ns), but
+    those are rare in these problems. Pass IntegerParser::Avx2 to FastInput to use it anyway.
+
+    The SIMD kernels read a whole vector past the first digit, so the caller must only use
+    them when at least 32 (AVX2) / 16 (SSE4.1) bytes are left in the input.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+enum class IntegerParser { Scalar, Sse41, Avx2 };
+
+// Classic loop, also used near the end of the input where a full vector can't be loaded
+inline uint64_t parseDigitsScalar(const char*& p, const char* end) {
+    uint64_t value = 0;
+    while (p < end && (unsigned char)(*p - '0') <= 9) {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+inline bool integerParserSupported(IntegerParser kind) {
+    __builtin_cpu_init();
+    if (kind == IntegerParser::Avx2) return __builtin_cpu_supports("avx2");
+    if (kind == IntegerParser::Sse41) return __builtin_cpu_supports("sse4.1");
+    return true;
+}
+
+inline IntegerParser detectIntegerParser() {
+    return integerParserSupported(IntegerParser::Sse41) ? IntegerParser::Sse41 : IntegerParser::Scalar;
+}
+
+// shuffleMasks[k] moves the first k bytes of a vector to its last k lanes and zeroes the rest
+struct DigitShuffleMasks {
+    alignas(16) char masks[17][16];
+    constexpr DigitShuffleMasks() : masks() {
+        for (int k = 0; k <= 16; ++k) {
+            for (int lane = 0; lane < 16; ++lane) {
+                int source = lane - (16 - k);
+                masks[k][lane] = source >= 0 ? char(source) : char(0x80);
+            }
+        }
+    }
+};
+inline constexpr DigitShuffleMasks digitShuffleMasks{};
+
+// Converts the `length` (1..16) digits starting at p; 16 bytes from p must be readable
+__attribute__((target("sse4.1"), always_inline))
+inline uint64_t convertDigitsSse41(const char* p, int length) {
+    __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), _mm_set1_epi8('0'));
+    digits = _mm_shuffle_epi8(digits, _mm_load_si128((const __m128i*)digitShuffleMasks.masks[length]));
+
+    __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    quads = _mm_packus_epi32(quads, quads);
+    __m128i octets = _mm_madd_epi16(quads, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+    uint64_t high = (uint32_t)_mm_cvtsi128_si32(octets);
+    uint64_t low = (uint32_t)_mm_extract_epi32(octets, 1);
+    return high * 100000000ULL + low;
+}
+
+// Converts `length` (1..31) digits, the last 16 of them with the vector kernel
+__attribute__((target("sse4.1"), always_inline))
+inline uint64_t convertDigitRun(const char*& p, int length) {
+    const char* stop = p + length;
+    uint64_t leading = 0;
+    if (length > 16) {
+        leading = parseDigitsScalar(p, p + (length - 16));
+        length = 16;
+    }
+    uint64_t value = leading * 10000000000000000ULL + convertDigitsSse41(p, length);
+    p = stop;
+    return value;
+}
+
+// Bit i is set if p[i] is not a digit
+__attribute__((target("sse4.1"), always_inline))
+inline unsigned nonDigitMaskSse41(const char* p) {
+    __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+    __m128i nonDigit = _mm_or_si128(_mm_cmplt_epi8(bytes, _mm_set1_epi8('0')),
+                                    _mm_cmpgt_epi8(bytes, _mm_set1_epi8('9')));
+    return (unsigned)_mm_movemask_epi8(nonDigit);
+}
+
+// Needs at least 16 readable bytes from p
+__attribute__((target("sse4.1")))
+inline uint64_t parseDigitsSse41(const char*& p, const char* end) {
+    unsigned mask = nonDigitMaskSse41(p);
+    if (mask == 0) {
+        // 16+ digits: the end is in the next 16 bytes, if they can be read
+        if (end - p < 32) return parseDigitsScalar(p, end);
+        mask = nonDigitMaskSse41(p + 16);
+        if (mask == 0) return parseDigitsScalar(p, end);   // 32+ digits, not a valid integer anyway
+        return convertDigitRun(p, 16 + __builtin_ctz(mask));
+    }
+    int length = __builtin_ctz(mask);
+    if (length == 0) return 0;
+    return convertDigitRun(p, length);
+}
+
+// Needs at least 32 readable bytes from p
+__attribute__((target("avx2")))
+inline uint64_t parseDigitsAvx2(const char*& p, const char* end) {
+    __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+    __m256i nonDigit = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8('0'), bytes),
+                                       _mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('9')));
+    unsigned mask = (unsigned)_mm256_movemask_epi8(nonDigit);
+    if (mask == 0) return parseDigitsScalar(p, end);   // 32+ digits, not a valid integer anyway
+    int length = __builtin_ctz(mask);
+    if (length == 0) return 0;
+    return convertDigitRun(p, length);
+}
+
+#else
+
+inline bool integerParserSupported(IntegerParser kind) {
+    return kind == IntegerParser::Scalar;
+}
+
+inline IntegerParser detectIntegerParser() {
+    return IntegerParser::Scalar;
+}
+
+inline uint64_t parseDigitsSse41(const char*& p, const char* end) { return parseDigitsScalar(p, end); }
+inline uint64_t parseDigitsAvx2(const char*& p, const char* end) { return parseDigitsScalar(p, end); }
+
+#endif
@@ -0,0 +1,164 @@
+/*
+    SPARSE SEGMENT TREE (64-BIT KEYS, PATH-COMPRESSED)
+    ==================================================
+    A segment tree over the key space [0, 2^63) instead of a dense array: keys are sparse
+    64-bit IDs, inserted online, with no coordinate compression. Keys that were never set
+    hold the identity, so query(l, r) combines the values of the keys set in [l, r].
+
+KEY CONCEPTS:
+    1. Lazy Nodes - Only the parts of the tree that contain keys exist. A plain dynamic tree
+       creates the whole root-to-leaf path for every key, 63 nodes per key.
+    2. Path Compression - Most of those nodes would have a single child. Here a node is only
+       created where two keys part ways, so every internal node has exactly two children and
+       k keys take exactly 2k - 1 nodes. A node stores the block of keys it covers, as an
+       aligned range [prefix, prefix + 2^level): level 0 is a single key (a leaf), and the
+       children of a node cover parts of its two halves, possibly at much lower levels.
+    3. Arena - Nodes live in one vector and are bump-allocated from its end; children are
+       32-bit indices into it (0 means "none"), like in PersistentSegmentTree
+       (Persistent_Segment_Tree.h). No allocation per node, and a node is 32 bytes for
+       long long values instead of 40 with two pointers.
+
+ALGORITHMS:
+
+    Point Update (key, value), starting at the root:
+      1. No node        → create a leaf for key
+      2. Node's block does not contain key
+                        → create a new internal node for the smallest aligned block that
+                          contains both (its level is the highest bit where key and prefix
+                          differ, plus one) with the old node and a new leaf as children
+      3. Leaf of key    → overwrite its value
+      4. Internal node  → recurse into the half that contains key, recalculate the node
+      The levels strictly decrease along every path, so a path has at most 64 nodes.
+
+    Range Query [l, r]:
+      The three cases of SegmentTree (Segment_Tree.h) with the node's block as the segment.
+      Leaves are never partially covered.
+
+    Time Complexity: O(log U) per update and query, U = 2^63
+    Space Complexity: O(k) for k distinct keys (2k - 1 nodes)
+
+USAGE:
+    SparseSegmentTree<SumMonoid<long long>> tree;         // Optional: tree(expectedKeys) to reserve
+    tree.updateValue(9000000000000000000ull, 5);          // Any key < 2^63, set or overwrite
+    long long sum = tree.query(0, 1ull << 62);
+    size_t nodes = tree.nodeCount();                       // 2 × keys - 1
+*/
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Monoids.h"
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class SparseSegmentTree {
+    static const uint32_t NONE = 0;     // nodes[0] is a placeholder, never a real node
+
+    struct Node {
+        T value;
+        uint64_t prefix;        // First key of the block; the low `level` bits are 0
+        uint32_t child[2];      // Halves of the block, NONE in leaves
+        int level;              // The block has 2^level keys
+    };
+
+    std::vector<Node> nodes;
+    uint32_t root = NONE;
+    size_t keyCount = 0;
+
+    uint32_t createNode(const T& value, uint64_t prefix, int level, uint32_t left, uint32_t right) {
+        nodes.push_back({value, prefix, {left, right}, level});
+        return nodes.size() - 1;
+    }
+
+    static bool contains(const Node& node, uint64_t key) {
+        return (key >> node.level) == (node.prefix >> node.level);
+    }
+
+    // Returns the node that replaces nodeIndex after setting key to value below it.
+    // No references into `nodes` are held across createNode(): it may reallocate.
+    uint32_t pointUpdate(const uint32_t nodeIndex, const uint64_t key, const T& value) {
+        // CASE 1: Empty subtree
+        if (nodeIndex == NONE) {
+            ++keyCount;
+            return createNode(value, key, 0, NONE, NONE);
+        }
+
+        // CASE 2: The key lies outside the node's block - join both under a new node
+        const Node node = nodes[nodeIndex];
+        if (!contains(node, key)) {
+            const int level = std::bit_width(key ^ node.prefix);
+            ++keyCount;
+            const uint32_t leaf = createNode(value, key, 0, NONE, NONE);
+            const bool keyOnRight = (key >> (level - 1)) & 1;
+            const uint32_t left = keyOnRight ? nodeIndex : leaf, right = keyOnRight ? leaf : nodeIndex;
+            return createNode(Monoid::combine(nodes[left].value, nodes[right].value),
+                              key >> level << level, level, left, right);
+        }
+
+        // CASE 3: Leaf of this key
+        if (node.level == 0) {
+            nodes[nodeIndex].value = value;
+            return nodeIndex;
+        }
+
+        // CASE 4: Internal node - update the half that contains the key
+        const int side = (key >> (node.level - 1)) & 1;
+        const uint32_t child = pointUpdate(node.child[side], key, value);
+        nodes[nodeIndex].child[side] = child;
+        nodes[nodeIndex].value = Monoid::combine(nodes[nodes[nodeIndex].child[0]].value,
+                                                 nodes[nodes[nodeIndex].child[1]].value);
+        return nodeIndex;
+    }
+
+    T rangeQuery(const uint32_t nodeIndex, const uint64_t queryStart, const uint64_t queryEnd) const {
+        if (nodeIndex == NONE) return Monoid::identity();
+        const Node& node = nodes[nodeIndex];
+        const uint64_t segmentStart = node.prefix;
+        const uint64_t segmentEnd = node.prefix + ((uint64_t(1) << node.level) - 1);
+
+        // CASE 1: Block completely lies inside the query range
+        if (queryStart <= segmentStart && segmentEnd <= queryEnd) return node.value;
+
+        // CASE 2: Block completely lies outside the query range
+        if (queryEnd < segmentStart || segmentEnd < queryStart) return Monoid::identity();
+
+        // CASE 3: Partial overlap (only internal nodes get here)
+        return Monoid::combine(rangeQuery(node.child[0], queryStart, queryEnd),
+                               rangeQuery(node.child[1], queryStart, queryEnd));
+    }
+
+public:
+    explicit SparseSegmentTree(size_t expectedKeys = 0) {
+        nodes.reserve(2 * expectedKeys + 1);
+        nodes.push_back({Monoid::identity(), 0, {NONE, NONE}, 0});
+    }
+
+    // Sets key (< 2^63) to value. A larger key would need a block of level 64, and
+    // shifting a uint64_t by 64 bits is undefined.
+    void updateValue(uint64_t key, const T& value) {
+        assert(key < (uint64_t(1) << 63) && "SparseSegmentTree keys must be < 2^63");
+        root = pointUpdate(root, key, value);
+    }
+
+    // Combination of the values of all keys set in [rangeStart, rangeEnd]
+    T query(uint64_t rangeStart, uint64_t rangeEnd) const {
+        return rangeQuery(root, rangeStart, rangeEnd);
+    }
+
+    // Number of distinct keys ever set
+    size_t size() const {
+        return keyCount;
+    }
+
+    size_t nodeCount() const {
+        return nodes.size() - 1;
+    }
+
+    // Bytes used by the arena
+    size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(Node);
+    }
+};
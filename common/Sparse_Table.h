@@ -0,0 +1,89 @@
+/*
+    SPARSE TABLE
+    ============
+    Immutable structure that answers range queries in O(1) for idempotent monoids
+    (MIN, MAX, GCD, AND, OR - see Monoids.h). There are no updates, so it is only
+    useful when the array never changes.
+
+TABLE STRUCTURE:
+    • table[k][i] stores combine(arr[i], ..., arr[i + 2^k - 1]), the answer for the
+      segment of length 2^k starting at i
+    • Level 0 is the array itself, level k is built from level k - 1:
+        table[k][i] = combine(table[k-1][i], table[k-1][i + 2^(k-1)])
+      Every element of a level is independent of the others, so the inner loop is a
+      plain element-wise loop over two contiguous arrays that the compiler vectorizes.
+    • All levels are stored one after another in a single vector (level k starts at k * n).
+
+RANGE QUERY [l, r]:
+    Let k be the largest power with 2^k ≤ (r - l + 1), i.e. k = 31 - __builtin_clz(r - l + 1).
+    The two segments [l, l + 2^k - 1] and [r - 2^k + 1, r] cover the whole range. They may
+    overlap, which is fine only because combine(x, x) == x for idempotent operations:
+        answer = combine(table[k][l], table[k][r - 2^k + 1])
+
+    queryBatch() has the same interface as the segment trees, but it is a plain loop: both
+    lookups of a query are independent loads, so the CPU already overlaps their cache misses.
+
+    Time Complexity: O(n log n) build, O(1) per query
+    Space Complexity: O(n log n)
+
+USAGE:
+    SparseTable<MinMonoid<long long>> table(array, size);
+    long long result = table.query(left, right);
+    table.queryBatch(ranges, answers);   // span<const pair<int, int>>, span<long long>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class SparseTable {
+    static_assert(Monoid::idempotent, "SparseTable needs an idempotent monoid (min, max, gcd, and, or)");
+
+    int n, levels;
+    std::vector<T> table;
+
+    static int floorLog2(unsigned x) {
+        return 31 - __builtin_clz(x);
+    }
+
+public:
+    template <class U>
+    SparseTable(const U arr[], int n) {
+        this->n = n;
+        levels = floorLog2(n) + 1;
+        table.resize((size_t)levels * n);
+
+        for (int i = 0; i < n; ++i) table[i] = T(arr[i]);
+
+        for (int k = 1; k < levels; ++k) {
+            const T* previous = table.data() + (size_t)(k - 1) * n;
+            T* current = table.data() + (size_t)k * n;
+            const int half = 1 << (k - 1);
+            const int count = n - (1 << k) + 1;
+            for (int i = 0; i < count; ++i) {
+                current[i] = Monoid::combine(previous[i], previous[i + half]);
+            }
+        }
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        int k = floorLog2(rangeEnd - rangeStart + 1);
+        const T* level = table.data() + (size_t)k * n;
+        return Monoid::combine(level[rangeStart], level[rangeEnd - (1 << k) + 1]);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        for (size_t i = 0; i < ranges.size(); ++i) out[i] = query(ranges[i].first, ranges[i].second);
+    }
+
+    // Bytes used by the table
+    size_t memoryUsage() const {
+        return table.capacity() * sizeof(T);
+    }
+};
@@ -0,0 +1,114 @@
+/*
+    SINGLE-PRODUCER SINGLE-CONSUMER RING
+    ====================================
+    Bounded FIFO queue between exactly two threads: one thread only pushes, the other only
+    pops. This is the hand-off between the stages of Query_Pipeline.h.
+
+HOW IT WORKS:
+    • The values live in a power-of-two array. `tail` counts the values pushed so far and
+      `head` the values popped; slot i of the array holds value number i mod capacity.
+      Both counters only grow, so "empty" is head == tail and "full" is tail - head == capacity.
+    • Each counter is written by one thread only. The producer publishes a value with a
+      release store of `tail` after writing the slot; the consumer reads `tail` with an
+      acquire load before reading the slot (and the same the other way round for `head`).
+      No locks, no compare-and-swap.
+    • The producer's and the consumer's fields are on separate cache lines, so the two
+      threads do not invalidate each other's line on every operation. Each side also keeps
+      a private copy of the other side's counter and re-reads the shared one only when the
+      copy says the ring is full (or empty), so most operations touch no shared line at all.
+    • pop() takes as many values as are available (up to the space given) in one go, so a
+      single acquire load is paid for a whole batch.
+    • A side that has to wait spins briefly and then yields its core, which keeps the ring
+      usable when there are fewer cores than threads.
+    • close() marks the end of the stream: pop() returns 0 once the ring is closed and
+      drained.
+
+    Time Complexity: O(1) per push, O(k) per pop of k values
+    Space Complexity: O(capacity)
+
+USAGE:
+    SpscRing<Query> ring(1 << 14);          // Capacity, rounded up to a power of two
+    ring.push(query);                       // Producer thread, waits while full
+    ring.close();                           // Producer thread, after the last push
+    size_t count = ring.pop(buffer);        // Consumer thread, span<Query>; 0 = closed and empty
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <thread>
+
+template <class T>
+class SpscRing {
+    static const int SPINS_BEFORE_YIELD = 64;
+
+    size_t capacity, mask;
+    std::unique_ptr<T[]> slots;
+
+    // Written by the producer only
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<bool> closed{false};
+    size_t cachedHead = 0;
+
+    // Written by the consumer only
+    alignas(64) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+
+    template <class Ready>
+    static void waitUntil(Ready ready) {
+        for (int spins = 0; !ready(); ++spins) {
+            if (spins >= SPINS_BEFORE_YIELD) std::this_thread::yield();
+        }
+    }
+
+public:
+    explicit SpscRing(size_t capacity)
+        : capacity(std::bit_ceil(capacity)), mask(this->capacity - 1), slots(new T[this->capacity]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: appends `value`, waiting while the ring is full
+    void push(const T& value) {
+        const size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead == capacity) {
+            waitUntil([&] {
+                cachedHead = head.load(std::memory_order_acquire);
+                return position - cachedHead < capacity;
+            });
+        }
+        slots[position & mask] = value;
+        tail.store(position + 1, std::memory_order_release);
+    }
+
+    // Producer: no more values will be pushed
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    // Consumer: moves up to out.size() values into `out` and returns how many. Waits while
+    // the ring is empty; returns 0 only when the ring is closed and everything was popped.
+    size_t pop(std::span<T> out) {
+        const size_t position = head.load(std::memory_order_relaxed);
+        if (cachedTail == position) {
+            waitUntil([&] {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (cachedTail != position) return true;
+                if (!closed.load(std::memory_order_acquire)) return false;
+                // Values pushed before close() are visible now
+                cachedTail = tail.load(std::memory_order_acquire);
+                return true;
+            });
+            if (cachedTail == position) return 0;
+        }
+        const size_t count = std::min(out.size(), cachedTail - position);
+        for (size_t i = 0; i < count; ++i) out[i] = slots[(position + i) & mask];
+        head.store(position + count, std::memory_order_release);
+        return count;
+    }
+};
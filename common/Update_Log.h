@@ -0,0 +1,364 @@
+/*
+    WRITE-AHEAD UPDATE LOG WITH CHECKPOINTS
+    =======================================
+    Makes the array behind a dynamic range structure survive restarts. Every update is
+    appended to a binary log; from time to time the whole array is written as a checkpoint
+    and the log starts over. After a restart, recover() loads the last checkpoint and
+    applies the log tail to the plain array, and the caller builds its tree from that array
+    once: O(n + k) for k logged updates instead of replaying them through updateValue()
+    in O(k log n), and never more than one checkpoint interval of log to read.
+
+    Two kinds of updates are logged:
+      • assign(i, x, position)          - arr[i] = x        (point update, what the drivers use)
+      • rangeAdd(l, r, x, position)     - arr[j] += x for every j in [l, r]
+    `position` says how far the caller's input had got when it made the update (the drivers
+    pass the number of queries read). After recover(), resumePosition() is the position of
+    the last recovered update, so a restarted program skips that much input and continues
+    after it instead of applying the same updates again.
+
+FILES (native byte order, `path` is chosen by the caller):
+    • path + ".log": fixed-size records { sequence number, position, n, kind, l, r, value,
+      checksum }. Sequence numbers count all updates ever logged. The checksum covers the
+      record, so a record torn by a crash in the middle of a write is detected; recover()
+      drops it and everything after it.
+    • path + ".checkpoint": header { magic, format version, element size, n, sequence
+      number of the first update NOT included, position of the last update included,
+      checksum of the values } + the n values.
+      Written under a temporary name, synced and renamed, so there is always one complete
+      checkpoint. Then the log is truncated. If the process dies between the two steps,
+      the log still holds records the checkpoint already includes; recover() skips them
+      by sequence number.
+    • Files that do not belong to this array (another n, a checkpoint that fails its
+      checksum, records that are out of range or skip sequence numbers) are never modified:
+      recover() leaves the array as it was given, and logging is disabled (enabled() turns
+      false) so that the records in them are not overwritten.
+
+DURABILITY:
+    Records are collected in memory and written with one write(2) per LOG_BUFFER_RECORDS.
+    flush() writes them out now (survives a crash of the process), sync() also asks the
+    kernel to put them on disk (survives a crash of the machine).
+
+BATCHED REPLAY (recover):
+    • Only assignments: arr[i] = x in log order, O(k).
+    • Only range adds: a difference array, add[l] += x and add[r + 1] -= x, and one prefix
+      sum pass at the end, O(k + n).
+    • Both: for every index, only its last assignment matters, plus the adds logged after
+      it. Walking the log backwards, the first assignment met for index i is its last one,
+      and all adds met so far are exactly the ones after it. Those are kept in a Fenwick
+      tree over the difference array (range add, point query), so this case costs
+      O(k log n + n). Adds logged before the first assignment of the whole tail never
+      enter the Fenwick tree.
+
+USAGE:
+    UpdateLog<int> updateLog(path);                 // nullptr: logging disabled, all calls no-ops
+    updateLog.recover(span(nums, n));               // nums: initial array in, recovered array out
+    ... skip the first updateLog.resumePosition() queries, build the tree from nums ...
+    updateLog.assign(index, value, queriesRead);    // Log before or after applying, in order
+    if (updateLog.checkpointDue()) updateLog.checkpoint(span(nums, n));
+    updateLog.flush();
+*/
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Checksum.h"
+#include "Fenwick_Tree.h"
+
+template <class T>
+class UpdateLog {
+    static_assert(std::is_trivially_copyable_v<T>, "logged values are written as raw bytes");
+
+    enum Kind : uint32_t { ASSIGN = 1, RANGE_ADD = 2 };
+
+    struct Record {
+        uint64_t sequence;
+        uint64_t position;          // Caller's input position at this update
+        uint32_t size, kind;        // size: n of the array it was logged for
+        int32_t left, right;        // left == right for assignments
+        T value;
+        uint64_t checksum;          // Of all bytes before this field
+    };
+
+    struct CheckpointHeader {
+        char magic[8];
+        uint32_t formatVersion, elementSize;
+        uint64_t size, sequence, position, checksum;
+    };
+
+    static constexpr char MAGIC[8] = {'U', 'P', 'D', 'C', 'K', 'P', 'T', '\0'};
+    static const uint32_t FORMAT_VERSION = 2;
+    static const size_t LOG_BUFFER_RECORDS = 4096;
+
+    std::string logPath, checkpointPath;
+    int fd = -1;
+    uint64_t nextSequence = 0;
+    uint64_t lastPosition = 0;
+    uint64_t checkpointInterval, recordsSinceCheckpoint = 0;
+    uint32_t arraySize = 0;     // Set by recover()
+    std::vector<Record> buffer;
+
+    static uint64_t recordChecksum(const Record& record) {
+        return checksum64(&record, offsetof(Record, checksum));
+    }
+
+    void append(uint32_t kind, int left, int right, const T& value, uint64_t position) {
+        if (fd < 0) return;
+        Record record;
+        memset(&record, 0, sizeof(record));     // Padding bytes are part of the checksum
+        record.sequence = nextSequence++;
+        record.position = lastPosition = position;
+        record.size = arraySize;
+        record.kind = kind;
+        record.left = left;
+        record.right = right;
+        record.value = value;
+        record.checksum = recordChecksum(record);
+        buffer.push_back(record);
+        ++recordsSinceCheckpoint;
+        if (buffer.size() >= LOG_BUFFER_RECORDS) flush();
+    }
+
+    static bool writeAll(int fd, const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t count = write(fd, bytes, size);
+            if (count <= 0) return false;
+            bytes += count, size -= count;
+        }
+        return true;
+    }
+
+    // Reads the checkpoint into `values` (n of them) and `header`. Without a checkpoint
+    // file, `values` stays empty and header.sequence and header.position are 0. Returns
+    // false if there is a checkpoint but it is not one of n intact values of type T.
+    bool loadCheckpoint(size_t n, std::vector<T>& values, CheckpointHeader& header) const {
+        memset(&header, 0, sizeof(header));
+        int checkpointFd = open(checkpointPath.c_str(), O_RDONLY);
+        if (checkpointFd < 0) return errno == ENOENT;
+        values.resize(n);
+        const size_t valueBytes = n * sizeof(T);
+        bool ok = read(checkpointFd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+                  memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.formatVersion == FORMAT_VERSION &&
+                  header.elementSize == sizeof(T) && header.size == n &&
+                  read(checkpointFd, values.data(), valueBytes) == (ssize_t)valueBytes &&
+                  checksum64(values.data(), valueBytes) == header.checksum;
+        close(checkpointFd);
+        return ok;
+    }
+
+    void disable() {
+        if (fd >= 0) close(fd);
+        fd = -1;
+        buffer.clear();
+    }
+
+    // Applies the records in log order to `leaves` (see "Batched Replay" above)
+    static void replay(std::span<const Record> records, std::span<T> leaves) {
+        const int n = leaves.size();
+        size_t firstAssign = records.size();
+        bool hasAdds = false;
+        for (size_t t = 0; t < records.size(); ++t) {
+            if (records[t].kind == ASSIGN && firstAssign == records.size()) firstAssign = t;
+            if (records[t].kind == RANGE_ADD) hasAdds = true;
+        }
+        if (!hasAdds) {
+            for (const Record& record : records) leaves[record.left] = record.value;
+            return;
+        }
+
+        std::vector<T> adds(n + 1, T(0));       // Difference array of all adds
+        std::vector<T> zeros(n + 1, T(0));
+        FenwickTree<T> laterAdds(zeros.data(), n + 1);  // Adds after the current record
+        std::vector<char> assigned(n, false);
+        for (size_t t = records.size(); t-- > 0;) {
+            const Record& record = records[t];
+            if (record.kind == RANGE_ADD) {
+                adds[record.left] += record.value;
+                adds[record.right + 1] -= record.value;
+                if (t > firstAssign) {
+                    laterAdds.addValue(record.left, record.value);
+                    laterAdds.addValue(record.right + 1, -record.value);
+                }
+            } else if (!assigned[record.left]) {
+                assigned[record.left] = true;
+                leaves[record.left] = record.value + laterAdds.query(0, record.left);
+            }
+        }
+        T added = T(0);
+        for (int i = 0; i < n; ++i) {
+            added += adds[i];
+            if (!assigned[i]) leaves[i] += added;
+        }
+    }
+
+public:
+    // Logs to path + ".log" and checkpoints to path + ".checkpoint". A null path disables
+    // the log: every call is then a no-op.
+    explicit UpdateLog(const char* path, uint64_t checkpointInterval = 1 << 20)
+        : checkpointInterval(checkpointInterval) {
+        if (path == nullptr) return;
+        logPath = std::string(path) + ".log";
+        checkpointPath = std::string(path) + ".checkpoint";
+        fd = open(logPath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        buffer.reserve(LOG_BUFFER_RECORDS);
+    }
+
+    ~UpdateLog() {
+        flush();
+        if (fd >= 0) close(fd);
+    }
+
+    UpdateLog(const UpdateLog&) = delete;
+    UpdateLog& operator=(const UpdateLog&) = delete;
+
+    bool enabled() const {
+        return fd >= 0;
+    }
+
+    // `leaves` holds the initial array. If there is a checkpoint it replaces them; then the
+    // valid part of the log is applied on top, and a torn tail is cut off. If the files do
+    // not fit this array, `leaves` is left alone and logging is disabled (files untouched).
+    // Call once, before logging anything (records carry n, which recover() sets). Returns the
+    // number of log records applied.
+    size_t recover(std::span<T> leaves) {
+        if (fd < 0) return 0;
+        arraySize = leaves.size();
+        std::vector<T> checkpointValues;
+        CheckpointHeader checkpointHeader;
+        if (!loadCheckpoint(leaves.size(), checkpointValues, checkpointHeader)) {
+            disable();
+            return 0;
+        }
+        const uint64_t checkpointSequence = checkpointHeader.sequence;
+        nextSequence = checkpointSequence;
+        lastPosition = checkpointHeader.position;
+
+        // The log is read LOG_BUFFER_RECORDS at a time; one read(2) per record would cost
+        // more than the whole replay
+        std::vector<Record> records;
+        off_t validBytes = 0;
+        lseek(fd, 0, SEEK_SET);
+        bool valid = true, fits = true;
+        while (valid) {
+            const size_t oldSize = records.size();
+            records.resize(oldSize + LOG_BUFFER_RECORDS);
+            const ssize_t count = read(fd, records.data() + oldSize, LOG_BUFFER_RECORDS * sizeof(Record));
+            const size_t complete = count > 0 ? count / sizeof(Record) : 0;
+            records.resize(oldSize + complete);
+            if (complete < LOG_BUFFER_RECORDS) valid = false;   // End of the log (or a torn record)
+
+            size_t kept = oldSize;
+            for (size_t t = oldSize; t < oldSize + complete; ++t) {
+                const Record& record = records[t];
+                if (record.checksum != recordChecksum(record)) {    // Torn by a crash
+                    valid = false;
+                    break;
+                }
+                if (record.sequence < checkpointSequence) {         // Already in the checkpoint
+                    validBytes += sizeof(Record);
+                    continue;
+                }
+                // An intact record that does not continue the checkpoint or does not fit the
+                // array: the log belongs to something else
+                fits = record.sequence == nextSequence && record.size == leaves.size() &&
+                       (record.kind == ASSIGN || record.kind == RANGE_ADD) && 0 <= record.left &&
+                       record.left <= record.right && record.right < (int64_t)leaves.size();
+                if (!fits) {
+                    valid = false;
+                    break;
+                }
+                validBytes += sizeof(Record);
+                records[kept++] = record;
+                ++nextSequence;
+                lastPosition = record.position;
+            }
+            records.resize(kept);
+        }
+        if (!fits) {
+            nextSequence = lastPosition = 0;
+            disable();
+            return 0;
+        }
+        // Cuts off a torn record at the end, so new records follow the valid ones. If that is
+        // not possible, stop logging: records behind a torn one would never be recovered.
+        if (ftruncate(fd, validBytes) != 0) disable();
+
+        if (!checkpointValues.empty()) std::copy(checkpointValues.begin(), checkpointValues.end(), leaves.begin());
+        recordsSinceCheckpoint = records.size();
+        replay(records, leaves);
+        return records.size();
+    }
+
+    // Input position of the last update recover() restored (0 if none): the caller has
+    // already consumed its input up to there
+    uint64_t resumePosition() const {
+        return lastPosition;
+    }
+
+    void assign(int index, const T& value, uint64_t position) {
+        append(ASSIGN, index, index, value, position);
+    }
+
+    void rangeAdd(int rangeStart, int rangeEnd, const T& delta, uint64_t position) {
+        append(RANGE_ADD, rangeStart, rangeEnd, delta, position);
+    }
+
+    // Writes the buffered records to the log file
+    void flush() {
+        if (fd < 0 || buffer.empty()) return;
+        writeAll(fd, buffer.data(), buffer.size() * sizeof(Record));
+        buffer.clear();
+    }
+
+    // flush(), and waits until the records are on disk
+    void sync() {
+        flush();
+        if (fd >= 0) fdatasync(fd);
+    }
+
+    bool checkpointDue() const {
+        return fd >= 0 && recordsSinceCheckpoint >= checkpointInterval;
+    }
+
+    // Saves `leaves`, which must include every update logged so far, and empties the log
+    bool checkpoint(std::span<const T> leaves) {
+        if (fd < 0) return false;
+        CheckpointHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.formatVersion = FORMAT_VERSION;
+        header.elementSize = sizeof(T);
+        header.size = leaves.size();
+        header.sequence = nextSequence;
+        header.position = lastPosition;
+        header.checksum = checksum64(leaves.data(), leaves.size_bytes());
+
+        const std::string temporaryPath = checkpointPath + ".tmp";
+        int checkpointFd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (checkpointFd < 0) return false;
+        bool ok = writeAll(checkpointFd, &header, sizeof(header)) &&
+                  writeAll(checkpointFd, leaves.data(), leaves.size_bytes()) && fsync(checkpointFd) == 0;
+        close(checkpointFd);
+        if (!ok || rename(temporaryPath.c_str(), checkpointPath.c_str()) != 0) {
+            unlink(temporaryPath.c_str());
+            return false;
+        }
+
+        // Everything logged so far is in the checkpoint now. If the log cannot be emptied,
+        // recover() skips the old records by their sequence numbers.
+        buffer.clear();
+        recordsSinceCheckpoint = 0;
+        return ftruncate(fd, 0) == 0;
+    }
+};
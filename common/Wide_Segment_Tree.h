@@ -0,0 +1,291 @@
+/*
+    WIDE (B-ARY) SEGMENT TREE
+    =========================
+    Same interface as IterativeSegmentTree (query / updateValue / queryBatch), but every
+    node has B = 64 / sizeof(T) children instead of 2 (8 for long long), and the B children
+    of a node are stored next to each other in one cache-line-aligned block. The tree is
+    log_B(n) levels high instead of log_2(n): 6 levels instead of 18 for n = 2e5.
+
+TREE STRUCTURE:
+    • Level 0 holds the array, padded with the identity to a multiple of B
+    • Entry j of level k+1 = combine of the block of entries [jB, jB + B) of level k
+    • Levels are built until one fits into a single block; all of them live in one array
+
+ALGORITHMS:
+
+    Range Query [l, r]  (half-open [l, r + 1) internally)
+      On every level, starting at the leaves:
+        • if l and r - 1 are in the same block → combine the entries [l, r) of that block, done
+        • otherwise take the partial block at the left end ([l, end of its block)) and the
+          partial block at the right end ([start of its block, r)), then continue one level
+          up with l = first whole block, r = one past the last whole block
+      Taking "entries [lo, hi) of a block" is one vector operation: load the whole block,
+      replace the lanes outside [lo, hi) with the identity, and reduce.
+
+    Batched Range Queries
+      When the tree is larger than the L2 cache, queryBatch() runs 16 queries in lock-step
+      one level at a time and prefetches their next blocks (like IterativeSegmentTree).
+      Smaller trees are cached anyway, so it just answers the queries one by one.
+
+    Point Update
+      Write the leaf, then on every level recompute the parent from its block
+      (the children left of the updated one, the new value, the children right of it).
+
+    SIMD: for SUM / MIN / MAX over long long, blocks are reduced with AVX2 (two 256-bit
+    registers per block). Like FastInput, the AVX2 code is compiled with target attributes
+    and picked at runtime, so the program runs on CPUs without AVX2 (and on non-x86)
+    with the plain loop. Every other monoid always uses the plain loop.
+
+    Measured (benchmarks/Wide_Segment_Tree_Benchmark.cpp): for n = 2e5 a MIN query takes
+    ~60 ns against ~150 ns on IterativeSegmentTree, updates cost about the same. Once the
+    tree no longer fits in L2 (n = 1e6) the difference mostly disappears. For SUM,
+    FenwickTree is still a little faster.
+
+    Time Complexity: O(n) build, O(log_B n) block operations per query and update
+    Space Complexity: about n * B / (B - 1)
+
+USAGE:
+    WideSegmentTree<MinMonoid<long long>> tree(array, size);
+    long long result = tree.query(left, right);
+    tree.updateValue(index, newValue);
+    tree.queryBatch(ranges, answers);   // span<const pair<int, int>>, span<long long>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+#include "Monoids.h"
+#include "Node_Layouts.h"
+#include "Avx2_Lanes.h"
+
+// Reduces the entries [lo, hi) of one block of B values. The generic version is a plain loop.
+template <class Monoid, class T, int B>
+struct WideBlockKernel {
+    static constexpr bool HAS_AVX2 = false;
+
+    static T reduce(const T* block, int lo, int hi) {
+        T result = Monoid::identity();
+        for (int i = lo; i < hi; ++i) result = Monoid::combine(result, block[i]);
+        return result;
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Block of 8 long longs (one cache line, 64-byte aligned) reduced in two AVX2 registers
+template <class Monoid, class Lanes>
+struct LongLongBlockKernel {
+    static constexpr bool HAS_AVX2 = true;
+
+    static long long reduce(const long long* block, int lo, int hi) {
+        long long result = Monoid::identity();
+        for (int i = lo; i < hi; ++i) result = Monoid::combine(result, block[i]);
+        return result;
+    }
+
+    __attribute__((target("avx2"))) static long long reduceAvx2(const long long* block, int lo, int hi) {
+        const __m256i identity = _mm256_set1_epi64x(Monoid::identity());
+        const __m256i lowLanes = _mm256_setr_epi64x(0, 1, 2, 3);
+        const __m256i highLanes = _mm256_setr_epi64x(4, 5, 6, 7);
+        const __m256i first = _mm256_set1_epi64x(lo - 1);
+        const __m256i last = _mm256_set1_epi64x(hi);
+
+        // Lane i is kept when lo <= i < hi, every other lane becomes the identity
+        __m256i lowKeep = _mm256_and_si256(_mm256_cmpgt_epi64(lowLanes, first), _mm256_cmpgt_epi64(last, lowLanes));
+        __m256i highKeep = _mm256_and_si256(_mm256_cmpgt_epi64(highLanes, first), _mm256_cmpgt_epi64(last, highLanes));
+        __m256i low = _mm256_blendv_epi8(identity, _mm256_load_si256((const __m256i*)block), lowKeep);
+        __m256i high = _mm256_blendv_epi8(identity, _mm256_load_si256((const __m256i*)(block + 4)), highKeep);
+
+        return foldLanes<Lanes>(Lanes::combine(low, high));
+    }
+};
+
+template <> struct WideBlockKernel<SumMonoid<long long>, long long, 8> : LongLongBlockKernel<SumMonoid<long long>, SumLanes> {};
+template <> struct WideBlockKernel<MinMonoid<long long>, long long, 8> : LongLongBlockKernel<MinMonoid<long long>, MinLanes> {};
+template <> struct WideBlockKernel<MaxMonoid<long long>, long long, 8> : LongLongBlockKernel<MaxMonoid<long long>, MaxLanes> {};
+
+#endif
+
+template <class Monoid, class T = typename Monoid::ValueType>
+class WideSegmentTree {
+    static constexpr int B = 64 / sizeof(T) >= 2 ? int(64 / sizeof(T)) : 2;
+    using Kernel = WideBlockKernel<Monoid, T, B>;
+
+    // Below this size (about an L2 cache) the tree is cached and single walks, which stop as
+    // soon as they are done, beat the lock-step batch, which always walks every level
+    static const size_t LOCKSTEP_MIN_BYTES = 1 << 21;
+
+    int n;
+    bool useAvx2;
+    std::vector<int> levelStart;     // Level k occupies nodes[levelStart[k], levelStart[k + 1])
+    std::vector<T, CacheLineAllocator<T>> nodes;
+
+    // Shared by the scalar and the AVX2 entry points; `Simd` selects the block kernel
+    template <bool Simd>
+    __attribute__((always_inline)) T reduceBlock(const T* block, int lo, int hi) const {
+        if constexpr (Simd && Kernel::HAS_AVX2) return Kernel::reduceAvx2(block, lo, hi);
+        else return Kernel::reduce(block, lo, hi);
+    }
+
+    template <bool Simd>
+    __attribute__((always_inline)) T walkQuery(int l, int r) const {
+        T leftResult = Monoid::identity(), rightResult = Monoid::identity();
+        for (int level = 0; ; ++level) {
+            const T* data = nodes.data() + levelStart[level];
+            const int leftBlock = l / B, rightBlock = (r - 1) / B;
+
+            // Both ends inside one block: one (partial) block reduction finishes the query
+            if (leftBlock == rightBlock) {
+                T middle = reduceBlock<Simd>(data + leftBlock * B, l - leftBlock * B, r - leftBlock * B);
+                return Monoid::combine(Monoid::combine(leftResult, middle), rightResult);
+            }
+
+            // The blocks at both ends are taken here (whole or partial), the blocks between
+            // them are left to the next level. No data-dependent branches.
+            leftResult = Monoid::combine(leftResult, reduceBlock<Simd>(data + leftBlock * B, l - leftBlock * B, B));
+            rightResult = Monoid::combine(reduceBlock<Simd>(data + rightBlock * B, 0, r - rightBlock * B), rightResult);
+            l = leftBlock + 1;
+            r = rightBlock;
+            if (l >= r) return Monoid::combine(leftResult, rightResult);
+        }
+    }
+
+    // Runs up to BATCH walks of walkQuery() in lock-step, one level at a time, and prefetches
+    // the blocks every walk needs on the next level. Every walk takes all levels: a finished
+    // one reduces empty lane ranges, so the loop has no data-dependent branches.
+    template <bool Simd>
+    __attribute__((always_inline)) void walkBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        const int BATCH = 16;
+        const int levels = (int)levelStart.size() - 1;
+        int l[BATCH], r[BATCH];
+        T leftResult[BATCH], rightResult[BATCH];
+
+        for (size_t base = 0; base < ranges.size(); base += BATCH) {
+            const int count = ranges.size() - base < BATCH ? int(ranges.size() - base) : BATCH;
+            for (int i = 0; i < count; ++i) {
+                l[i] = ranges[base + i].first;
+                r[i] = ranges[base + i].second + 1;
+                leftResult[i] = rightResult[i] = Monoid::identity();
+                __builtin_prefetch(nodes.data() + l[i] / B * B);
+                __builtin_prefetch(nodes.data() + (r[i] - 1) / B * B);
+            }
+
+            for (int level = 0; level < levels; ++level) {
+                const T* data = nodes.data() + levelStart[level];
+                const T* nextData = nodes.data() + levelStart[level + 1];
+                for (int i = 0; i < count; ++i) {
+                    const bool active = l[i] < r[i];
+                    const int leftBlock = l[i] / B, rightBlock = (r[i] - 1) / B;   // Both 0 once finished
+                    const bool last = !active | (leftBlock == rightBlock);
+                    const int leftStart = l[i] - leftBlock * B;
+                    const int leftEnd = !active ? leftStart : last ? r[i] - leftBlock * B : B;
+                    const int rightEnd = last ? 0 : r[i] - rightBlock * B;
+                    leftResult[i] = Monoid::combine(leftResult[i], reduceBlock<Simd>(data + leftBlock * B, leftStart, leftEnd));
+                    rightResult[i] = Monoid::combine(reduceBlock<Simd>(data + rightBlock * B, 0, rightEnd), rightResult[i]);
+                    l[i] = last ? 0 : leftBlock + 1;
+                    r[i] = last ? 0 : rightBlock;
+                    __builtin_prefetch(nextData + l[i] / B * B);
+                    __builtin_prefetch(nextData + (r[i] - 1) / B * B);
+                }
+            }
+
+            for (int i = 0; i < count; ++i) out[base + i] = Monoid::combine(leftResult[i], rightResult[i]);
+        }
+    }
+
+    template <bool Simd>
+    __attribute__((always_inline)) void walkUpdate(int index, T value) {
+        for (int level = 0; level + 1 < (int)levelStart.size() - 1; ++level) {
+            // The new parent is built from the other children and `value` instead of reloading
+            // the block right after writing into it (a narrow store followed by a wide load of
+            // the same line stalls the pipeline)
+            const T* block = nodes.data() + levelStart[level] + index / B * B;
+            const int position = index % B;
+            T parent = Monoid::combine(Monoid::combine(reduceBlock<Simd>(block, 0, position), value),
+                                       reduceBlock<Simd>(block, position + 1, B));
+            nodes[levelStart[level] + index] = value;
+            value = parent;
+            index /= B;
+        }
+        nodes[levelStart[levelStart.size() - 2] + index] = value;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("avx2"), flatten)) T queryAvx2(int l, int r) const {
+        return walkQuery<true>(l, r);
+    }
+
+    __attribute__((target("avx2"), flatten))
+    void queryBatchAvx2(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        walkBatch<true>(ranges, out);
+    }
+
+    __attribute__((target("avx2"), flatten)) void updateAvx2(int index, const T& newValue) {
+        walkUpdate<true>(index, newValue);
+    }
+#else
+    T queryAvx2(int l, int r) const { return walkQuery<false>(l, r); }
+    void queryBatchAvx2(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        walkBatch<false>(ranges, out);
+    }
+    void updateAvx2(int index, const T& newValue) { walkUpdate<false>(index, newValue); }
+#endif
+
+public:
+    template <class U>
+    WideSegmentTree(const U arr[], int n) {
+        this->n = n;
+        useAvx2 = false;
+        if constexpr (Kernel::HAS_AVX2) useAvx2 = cpuSupportsAvx2();
+
+        // Every level is padded to whole blocks, so every block starts on a cache line.
+        // The last level is a single block.
+        int size = n;
+        int start = 0;
+        while (true) {
+            const int padded = (size + B - 1) / B * B;
+            levelStart.push_back(start);
+            start += padded;
+            if (padded == B) break;
+            size = padded / B;
+        }
+        levelStart.push_back(start);
+
+        nodes.assign(start, Monoid::identity());
+        for (int i = 0; i < n; ++i) nodes[i] = T(arr[i]);
+        for (int level = 0; level + 1 < (int)levelStart.size() - 1; ++level) {
+            const int blocks = (levelStart[level + 1] - levelStart[level]) / B;
+            for (int block = 0; block < blocks; ++block) {
+                nodes[levelStart[level + 1] + block] = Kernel::reduce(nodes.data() + levelStart[level] + block * B, 0, B);
+            }
+        }
+    }
+
+    T query(int rangeStart, int rangeEnd) const {
+        return useAvx2 ? queryAvx2(rangeStart, rangeEnd + 1) : walkQuery<false>(rangeStart, rangeEnd + 1);
+    }
+
+    // out[i] = query(ranges[i].first, ranges[i].second)
+    void queryBatch(std::span<const std::pair<int, int>> ranges, std::span<T> out) const {
+        if (memoryUsage() < LOCKSTEP_MIN_BYTES) {
+            for (size_t i = 0; i < ranges.size(); ++i) out[i] = query(ranges[i].first, ranges[i].second);
+        } else if (useAvx2) {
+            queryBatchAvx2(ranges, out);
+        } else {
+            walkBatch<false>(ranges, out);
+        }
+    }
+
+    void updateValue(int updateIndex, const T& newValue) {
+        if (useAvx2) updateAvx2(updateIndex, newValue);
+        else walkUpdate<false>(updateIndex, newValue);
+    }
+
+    // Bytes used by the tree
+    size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(T);
+    }
+};
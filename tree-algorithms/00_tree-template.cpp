@@ -1,6 +1,11 @@
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 class Tree {
     vector<vector<int>> adj;
     int numNodes; // Number of nodes in the tree
@@ -18,7 +23,7 @@ public:
 
     void inputEdge() {
         int u, v;
-        cin >> u >> v;
+        input >> u >> v;
         addEdge(u, v);
     }
 
@@ -32,10 +37,11 @@ public:
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     Tree tree(n);
     tree.inputTree();
 
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
-#include <iostream>
 #include <vector>
 #include <cmath>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 const int MAX_LOG = 19;     // Max possible log if n = 2 * 10^5
 int numEmployees, numQueries;
 vector<vector<int>> boss;
@@ -27,18 +31,19 @@ int bossKLevelAbove(int employee, int k) {
 
 int main() {
 
-    cin >> numEmployees >> numQueries;
+    input >> numEmployees >> numQueries;
     
     boss.resize(numEmployees + 1, vector<int>(MAX_LOG, 0));
-    for (int i = 2; i <= numEmployees; ++i) cin >> boss[i][0];
+    for (int i = 2; i <= numEmployees; ++i) input >> boss[i][0];
 
     binaryLift();
     
     while (numQueries--) {
         int employee, k;
-        cin >> employee >> k;
-        cout << bossKLevelAbove(employee, k) << endl;
+        input >> employee >> k;
+        output << bossKLevelAbove(employee, k) << '\n';
     }
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
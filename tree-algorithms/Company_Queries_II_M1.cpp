@@ -9,30 +9,48 @@ This code implements the simplest method, which is fastest to code using binary
 
 tin and tout are used to check if one node is ancestor of another in constant time. [Genius]
 
+The three tables can be saved to a binary snapshot and mapped back on later runs over the same
+tree, skipping the parsing and the DFS (see ../common/Index_Snapshot.h, set INDEX_SNAPSHOT=file).
+Each row of up is a std::array, so the whole table is one contiguous block that can be saved
+and mapped as it is.
+
 */
 
-#include <iostream>
+#include <array>
+#include <span>
 #include <vector>
 #include <cmath>
+#include "../common/Index_Snapshot.h"
+#include "../common/Parallel_Queries.h"
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 const int MAX_LOG = 19;     // 2^19 > 2*10^5
 int n, q, root, timer;
-vector<vector<int>> adj, up;
-vector<int> tin, tout;
+vector<vector<int>> adj;
+// Filled by dfs()
+vector<array<int, MAX_LOG>> upBuilt;
+vector<int> tinBuilt, toutBuilt;
+// What the queries read: the tables above, or the same tables mapped from a snapshot
+span<const array<int, MAX_LOG>> up;
+span<const int> tin, tout;
 
 void dfs(int currNode, int parent) {
-    tin[currNode] = ++timer;
+    tinBuilt[currNode] = ++timer;
 
-    up[currNode][0] = parent;
+    upBuilt[currNode][0] = parent;
     
     // We can be sure that we have already discovered all nodes which are above node currNode,
     // since we are doing DFS. So the following node will not result in bad bahaviour
     for (int i = 1; i < MAX_LOG; ++i) {
-        up[currNode][i] = up[up[currNode][i - 1]][i - 1];
+        upBuilt[currNode][i] = upBuilt[upBuilt[currNode][i - 1]][i - 1];
         // minor performance gain, stopping as soon as no ancestors present
-        if (up[currNode][i] == 0) break;
+        if (upBuilt[currNode][i] == 0) break;
     }
 
     for (int child : adj[currNode]) {
@@ -40,7 +58,7 @@ void dfs(int currNode, int parent) {
         dfs(child, currNode);
     }
 
-    tout[currNode] = ++timer;
+    toutBuilt[currNode] = ++timer;
 }
 
 // Checks if node u is ancestor of node v in O(1)
@@ -65,13 +83,13 @@ int lca(int u, int v) {
 
 void inputAndPreprocess() {
     adj.resize(n + 1);
-    up.resize(n + 1, vector<int>(MAX_LOG, 0));
-    tin.resize(n + 1);
-    tout.resize(n + 1);
+    upBuilt.assign(n + 1, {});
+    tinBuilt.resize(n + 1);
+    toutBuilt.resize(n + 1);
     
     for (int u = 2; u <= n; ++u) {
         int v;
-        cin >> v;
+        input >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
@@ -86,22 +104,39 @@ void inputAndPreprocess() {
     // But if we set 0 to be virtual parent of the root node, by exiting it after the root node
     // the function isAncestor(0, v) will return true for all nodes v
     // and will not update u to up[u][i] unnecessarily
-    tout[0] = tout[root] + 1;
+    toutBuilt[0] = toutBuilt[root] + 1;
 }
 
 int main() {
 
     timer = 0;
     root = 1;
-    cin >> n >> q;
-
-    inputAndPreprocess();
-
-    while (q--) {
-        int a, b;
-        cin >> a >> b;
-        cout << lca(a, b) << endl;
+    input >> n >> q;
+
+    IndexSnapshot snapshot(input, "Company_Queries_II_M1 v1");
+    if (snapshot.load()) {
+        up = snapshot.section<array<int, MAX_LOG>>("up", n + 1);
+        tin = snapshot.section<int>("tin", n + 1);
+        tout = snapshot.section<int>("tout", n + 1);
+        if (up.empty() || tin.empty() || tout.empty()) snapshot.discard();
+    }
+    if (!snapshot.loaded()) {
+        inputAndPreprocess();
+        up = upBuilt, tin = tinBuilt, tout = toutBuilt;
+        snapshot.add("up", up);
+        snapshot.add("tin", tin);
+        snapshot.add("tout", tout);
+        snapshot.save();
     }
 
+    // The tables are read-only from here on, so the queries are answered on all cores
+    // (Parallel_Queries.h) and printed in their original order afterwards
+    vector<pair<int, int>> queries(q);
+    for (auto& [a, b] : queries) input >> a >> b;
+    vector<int> answers(q);
+    answerInParallel(queries, answers, [](pair<int, int> query) { return lca(query.first, query.second); });
+    for (int answer : answers) output << answer << '\n';
+
+    output.flush();
     return 0;
 }
\ No newline at end of file
@@ -78,43 +78,87 @@ ALGORITHM BREAKDOWN:
         Ensure left ≤ right by swapping if needed
         Query segment tree for minimum height node in range [left, right]
         That node is the LCA of u and v
+        The tree is never modified after STEP 2, so all queries are read first and answered
+        on all cores (Parallel_Queries.h), then printed in their original order.
+
+    STEP 5 (optional): Snapshot
+    ────────────────────────────
+    height[], euler[], first[] and segtree[] depend only on the tree. When INDEX_SNAPSHOT
+    names a file, save() writes them there after the build, and on later runs with the same
+    tree load() maps them from it, skipping the input of the tree, STEP 1 and STEP 2
+    (../common/Index_Snapshot.h).
 */
 
-#include <iostream>
+#include <span>
 #include <vector>
 #include <cmath>
+#include "../common/Index_Snapshot.h"
+#include "../common/Parallel_Queries.h"
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 int n, q, root;
 vector<vector<int>> adjList;
 
 struct LCA {
-    vector<int> height, euler, first, segtree;
+    // Filled by build()
+    vector<int> heightBuilt, eulerBuilt, firstBuilt, segtreeBuilt;
     vector<bool> visited;
+    // What the queries read: the arrays above, or the same arrays mapped from a snapshot
+    span<const int> height, euler, first, segtree;
     int n;
 
-    LCA(vector<vector<int>>& adjList) {
+    void build(vector<vector<int>>& adjList) {
         n = adjList.size();
-        height.resize(n);
-        first.resize(n);
-        euler.reserve(n * 2);
+        heightBuilt.resize(n);
+        firstBuilt.resize(n);
+        eulerBuilt.reserve(n * 2);
         visited.assign(n, false);
         dfs(adjList, root);
-        int m = euler.size();
-        segtree.resize(m * 4);
+        int m = eulerBuilt.size();
+        segtreeBuilt.resize(m * 4);
         buildSegTree(1, 0, m - 1);
+        height = heightBuilt, euler = eulerBuilt, first = firstBuilt, segtree = segtreeBuilt;
+    }
+
+    // Uses the arrays of an earlier build(), saved with save(), if the snapshot has them for
+    // a tree with nodes 1..nodes (whose Euler tour has 2 × nodes - 1 entries)
+    bool load(IndexSnapshot& snapshot, int nodes) {
+        if (!snapshot.load()) return false;
+        height = snapshot.section<int>("height", nodes + 1);
+        euler = snapshot.section<int>("euler", 2 * nodes - 1);
+        first = snapshot.section<int>("first", nodes + 1);
+        segtree = snapshot.section<int>("segtree", 4 * (2 * nodes - 1));
+        if (height.empty() || euler.empty() || first.empty() || segtree.empty()) {
+            snapshot.discard();
+            return false;
+        }
+        n = first.size();
+        return true;
+    }
+
+    void save(IndexSnapshot& snapshot) const {
+        snapshot.add("height", height);
+        snapshot.add("euler", euler);
+        snapshot.add("first", first);
+        snapshot.add("segtree", segtree);
+        snapshot.save();
     }
 
     void dfs(vector<vector<int>>& adjList, int node, int h = 0) {
         visited[node] = true;
-        height[node] = h;
-        first[node] = euler.size();
-        euler.push_back(node);
+        heightBuilt[node] = h;
+        firstBuilt[node] = eulerBuilt.size();
+        eulerBuilt.push_back(node);
         for(int child : adjList[node]) {
             if (visited[child]) continue;
             dfs(adjList, child, h + 1);
-            euler.push_back(node);
+            eulerBuilt.push_back(node);
         }
     }
 
@@ -124,14 +168,14 @@ struct LCA {
     //   b:     Begin index - start of the range in euler[] array
     //   e:     End index - end of the range in euler[] array (inclusive)
     void buildSegTree(int node, int b, int e) {
-        if (b == e) segtree[node] = euler[b];
+        if (b == e) segtreeBuilt[node] = eulerBuilt[b];
         else {
             int mid = b + (e - b) / 2;
             buildSegTree(node << 1, b, mid);
             buildSegTree(node << 1 | 1, mid + 1, e);
-            int l = segtree[node << 1];
-            int r = segtree[node << 1 | 1];
-            segtree[node] = (height[l] < height[r]) ? l : r;
+            int l = segtreeBuilt[node << 1];
+            int r = segtreeBuilt[node << 1 | 1];
+            segtreeBuilt[node] = (heightBuilt[l] < heightBuilt[r]) ? l : r;
         }
     }
 
@@ -141,7 +185,7 @@ struct LCA {
     //   b:     Begin index - start of current segment's range in euler[] array
     //   e:     End index - end of current segment's range in euler[] array (inclusive)
     //   L, R:  Query range - we want min height node in euler[L..R]
-    int query(int node, int b, int e, int L, int R) {
+    int query(int node, int b, int e, int L, int R) const {
         if (b > R || e < L) return -1;
         if (b >= L && e <= R) return segtree[node];
         int mid = (b + e) >> 1;
@@ -152,7 +196,7 @@ struct LCA {
         return height[left] < height[right] ? left : right;
     }
 
-    int lca(int u, int v) {
+    int lca(int u, int v) const {
         int left = first[u];
         int right = first[v];
         if (left > right) swap(left, right);
@@ -163,24 +207,32 @@ struct LCA {
 int main() {
     
     root = 1;
-    cin >> n >> q;
-    
-    adjList.resize(n + 1);
+    input >> n >> q;
     
-    for (int u = 2; u <= n; ++u) {
-        int v;
-        cin >> v;
-        adjList[u].push_back(v);
-        adjList[v].push_back(u);
-    }
+    IndexSnapshot snapshot(input, "Company_Queries_II_M3 v1");
+    LCA queryProcessor;
+    if (!queryProcessor.load(snapshot, n)) {
+        adjList.resize(n + 1);
+        
+        for (int u = 2; u <= n; ++u) {
+            int v;
+            input >> v;
+            adjList[u].push_back(v);
+            adjList[v].push_back(u);
+        }
 
-    LCA queryProcessor(adjList);
-    
-    while (q--) {
-        int a, b;
-        cin >> a >> b;
-        cout << queryProcessor.lca(a, b) << endl;
+        queryProcessor.build(adjList);
+        queryProcessor.save(snapshot);
     }
-
+    
+    // The segment tree is read-only from here on, so the queries are answered on all cores
+    // (Parallel_Queries.h) and printed in their original order afterwards
+    vector<pair<int, int>> queries(q);
+    for (auto& [a, b] : queries) input >> a >> b;
+    vector<int> answers(q);
+    answerInParallel(queries, answers, [&](pair<int, int> query) { return queryProcessor.lca(query.first, query.second); });
+    for (int answer : answers) output << answer << '\n';
+
+    output.flush();
     return 0;
 }
\ No newline at end of file
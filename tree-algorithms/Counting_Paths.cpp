@@ -47,12 +47,16 @@ ALGORITHM:
         being carried up (i.e. numPaths[child] - decrements[i])
 */
 
-#include <iostream>
 #include <vector>
 #include <cmath>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 const int MAX_LOG = 19;     // 2^19 > 2*10^5
 int n, q, root;
 vector<vector<int>> adj, up;
@@ -115,7 +119,7 @@ inline void inputAndPreprocess() {
     
     for (int i = 0; i < n - 1; ++i) {
         int u, v;
-        cin >> u >> v;
+        input >> u >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
@@ -135,21 +139,20 @@ void dfsAndCountPaths(int node, int parent) {
 
 int main() {
 
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
     root = 1;
-    cin >> n >> q;
+    input >> n >> q;
 
     inputAndPreprocess();
 
     while (q--) {
         int a, b;
-        cin >> a >> b;
+        input >> a >> b;
         addPath(a, b);
     }
 
     dfsAndCountPaths(1, 0);
-    for (int i = 1; i <= n; ++i) cout << numPaths[i] << ' ';
+    for (int i = 1; i <= n; ++i) output << numPaths[i] << ' ';
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
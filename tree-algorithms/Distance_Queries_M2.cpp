@@ -26,30 +26,47 @@ ALGORITHM:
     1. Find LCA of the two nodes.
     2. Return depth[u] + depth[v] - 2 * depth[LCA(a, b)]
 
+    Reusing The Tables
+    ------------------------------
+    If INDEX_SNAPSHOT names a snapshot of depth and up built from the same tree, both are
+    mapped from it and STEP 1 is skipped (../common/Index_Snapshot.h).
 */
 
-#include <iostream>
+#include <array>
+#include <span>
 #include <vector>
 #include <cmath>
+#include "../common/Index_Snapshot.h"
+#include "../common/Parallel_Queries.h"
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 const int MAX_LOG = 19;     // 2^19 > 2*10^5
 int n, q, root;
-vector<vector<int>> adj, up;
-vector<int> depth;
+vector<vector<int>> adj;
+// Filled by dfs()
+vector<array<int, MAX_LOG>> upBuilt;
+vector<int> depthBuilt;
+// What the queries read: the tables above, or the same tables mapped from a snapshot
+span<const array<int, MAX_LOG>> up;
+span<const int> depth;
 
 void dfs(int currNode, int parent) {
 
-    depth[currNode] = depth[parent] + 1;
-    up[currNode][0] = parent;
+    depthBuilt[currNode] = depthBuilt[parent] + 1;
+    upBuilt[currNode][0] = parent;
     
     // We can be sure that we have already discovered all nodes which are above node currNode,
     // since we are doing DFS. So the following node will not result in bad bahaviour
     for (int i = 1; i < MAX_LOG; ++i) {
-        up[currNode][i] = up[up[currNode][i - 1]][i - 1];
+        upBuilt[currNode][i] = upBuilt[upBuilt[currNode][i - 1]][i - 1];
         // minor performance gain, stopping as soon as no ancestors present
-        if (up[currNode][i] == 0) break;
+        if (upBuilt[currNode][i] == 0) break;
     }
     
     for (int child : adj[currNode]) {
@@ -84,34 +101,47 @@ int distance(int u, int v) {
 
 void inputAndPreprocess() {
     adj.resize(n + 1);
-    up.resize(n + 1, vector<int>(MAX_LOG, 0));
-    depth.resize(n + 1, 0);
+    upBuilt.assign(n + 1, {});
+    depthBuilt.resize(n + 1, 0);
     
     for (int i = 0; i < n - 1; ++i) {
         int u, v;
-        cin >> u >> v;
+        input >> u >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
     
-    depth[0] = -1;
+    depthBuilt[0] = -1;
     dfs(root, 0);
 }
 
 int main() {
 
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
     root = 1;
-    cin >> n >> q;
-
-    inputAndPreprocess();
+    input >> n >> q;
 
-    while (q--) {
-        int a, b;
-        cin >> a >> b;
-        cout << distance(a, b) << endl;
+    IndexSnapshot snapshot(input, "Distance_Queries_M2 v1");
+    if (snapshot.load()) {
+        up = snapshot.section<array<int, MAX_LOG>>("up", n + 1);
+        depth = snapshot.section<int>("depth", n + 1);
+        if (up.empty() || depth.empty()) snapshot.discard();
     }
+    if (!snapshot.loaded()) {
+        inputAndPreprocess();
+        up = upBuilt, depth = depthBuilt;
+        snapshot.add("up", up);
+        snapshot.add("depth", depth);
+        snapshot.save();
+    }
+
+    // The tables are read-only from here on, so the queries are answered on all cores
+    // (Parallel_Queries.h) and printed in their original order afterwards
+    vector<pair<int, int>> queries(q);
+    for (auto& [a, b] : queries) input >> a >> b;
+    vector<int> answers(q);
+    answerInParallel(queries, answers, [](pair<int, int> query) { return distance(query.first, query.second); });
+    for (int answer : answers) output << answer << '\n';
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 vector<int> subordinates;
 vector<vector<int>> adj;
 
@@ -17,19 +22,20 @@ void dfs(int node) {
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     subordinates.resize(n + 1, -1);
     adj.resize(n + 1);
     int temp;
 
     for (int i = 2; i <= n; i++) {
-        cin >> temp;
+        input >> temp;
         adj[temp].push_back(i);
     }
 
     dfs(1);
 
-    for (int i = 1; i <= n; ++i) cout << subordinates[i] << ' ';
+    for (int i = 1; i <= n; ++i) output << subordinates[i] << ' ';
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
@@ -54,6 +54,8 @@ ALGORITHM:
     ------------------------
       • Type 1 (Update): Convert node to its entry time, then perform point update
       • Type 2 (Sum): Query range [entryTime[node], exitTime[node]] for subtree sum
+      The queries go through Query_Pipeline.h: with enough cores, parsing, the tree work and
+      printing the sums run on three threads at once, and the sums are printed in order.
 
 TIME COMPLEXITY:
     • Preprocessing: O(n) for DFS + O(n) for segment tree construction
@@ -63,10 +65,20 @@ TIME COMPLEXITY:
 SPACE COMPLEXITY: O(n) for arrays and segment tree
 */
 
-#include <iostream>
+#include <span>
 #include <vector>
+#include "../common/Query_Pipeline.h"
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
+struct Query {
+    int queryType, s, x;
+};
+
 const int maxN = 2e5 + 5;
 int n, q, root = 1;
 long long value[maxN];
@@ -163,10 +175,8 @@ public:
     }
 
     long long sumQuery(const int queryStart, const int queryEnd) const {
-        if (queryStart < 0 || queryEnd > n-1 || queryEnd < queryStart){
-            cout << "Invalid Query\n";
-            return -1;
-        }
+        // No message here: this runs on the compute thread, which must not touch the output
+        if (queryStart < 0 || queryEnd > n-1 || queryEnd < queryStart) return -1;
         return rangeSum(0, n-1, 0, queryStart, queryEnd);
     }
 
@@ -177,11 +187,11 @@ public:
 };
 
 void inputAndPreprocess() {
-    cin >> n >> q;
-    for (int i = 1; i <= n; ++i) cin >> value[i];
+    input >> n >> q;
+    for (int i = 1; i <= n; ++i) input >> value[i];
     for (int i = 0; i < n-1; ++i) {
         int u, v;
-        cin >> u >> v;
+        input >> u >> v;
         adjList[u].push_back(v);
         adjList[v].push_back(u);
     }
@@ -205,22 +215,24 @@ long long subtreeSum(const int node, const SegmentTree& tree) {
 }
 
 int main() {
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
 
     inputAndPreprocess();
     SegmentTree tree(eulerTourValues);
 
-    while(q--) {
-        int queryType, s, x;
-        cin >> queryType;
-        if (queryType == 1) {
-            cin >> s >> x;
-            updateNodeValue(s, x, tree);
-        } else {
-            cin >> s;
-            cout << subtreeSum(s, tree) << '\n';
-        }
-    }
+    runQueryPipeline<long long>(q,
+        [] {
+            Query query;
+            input >> query.queryType >> query.s;
+            if (query.queryType == 1) input >> query.x;
+            return query;
+        },
+        [&](span<const Query> records, auto& sums) {
+            for (const auto& [queryType, s, x] : records) {
+                if (queryType == 1) updateNodeValue(s, x, tree);
+                else sums.push(subtreeSum(s, tree));
+            }
+        },
+        [](long long sum) { output << sum << '\n'; });
+    output.flush();
     return 0;
 }
\ No newline at end of file
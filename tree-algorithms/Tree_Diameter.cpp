@@ -1,6 +1,11 @@
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 vector<int> dp;
 vector<vector<int>> adj;
 int diameter = 0;
@@ -33,18 +38,19 @@ void dfs(int node, int parent) {
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     dp.resize(n + 1, 0);
     adj.resize(n + 1);
     int u, v;
 
     for (int i = 1; i <= n - 1; i++) {
-        cin >> u >> v;
+        input >> u >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
 
     dfs(1, 0);
-    cout << diameter << endl;
+    output << diameter << '\n';
+    output.flush();
     return 0;
 }
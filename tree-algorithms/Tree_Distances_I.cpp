@@ -26,8 +26,13 @@ Key points to note in this problem:
 */
 
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 vector<vector<int>> adj;
 vector<int> distancesFromE1;
 vector<int> distancesFromE2;
@@ -61,14 +66,14 @@ void calculateDistances(int node, int parent, int distance, vector<int> &distanc
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     adj.resize(n + 1);
     distancesFromE1.resize(n + 1);
     distancesFromE2.resize(n + 1);
     int u, v;
 
     for (int i = 1; i <= n - 1; i++) {
-        cin >> u >> v;
+        input >> u >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
@@ -84,8 +89,9 @@ int main() {
     for (int i = 1; i <= n; i++) {
         // The farthest distance from node i is the maximum of the distances
         // from the two endpoints of the diameter
-        cout << max(distancesFromE1[i], distancesFromE2[i]) << " ";
+        output << max(distancesFromE1[i], distancesFromE2[i]) << " ";
     }
 
+    output.flush();
     return 0;
 }
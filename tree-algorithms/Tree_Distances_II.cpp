@@ -25,8 +25,13 @@
 */
 
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 class Tree {
     int numNodes; // Number of nodes in the tree
     int root = 1;
@@ -49,7 +54,7 @@ public:
 
     void inputEdge() {
         int u, v;
-        cin >> u >> v;
+        input >> u >> v;
         addEdge(u, v);
     }
 
@@ -93,22 +98,22 @@ public:
 
     void printTreeDistances() {
         for (int i = 1; i <= numNodes; ++i) {
-            cout << treeDistances[i] << " ";
+            output << treeDistances[i] << " ";
         }
     }
 
     void printSubtreeSizes() {
         for (int i = 1; i <= numNodes; ++i) {
-            cout << subtreeSize[i] << " ";
+            output << subtreeSize[i] << " ";
         }
-        cout << endl;
+        output << '\n';
     }
 
 };
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     Tree tree(n);
     tree.inputTree();
     tree.populateSubtreeSize(1, 0);
@@ -117,5 +122,6 @@ int main() {
     // tree.printSubtreeSizes();
     tree.printTreeDistances();
 
+    output.flush();
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include <bits/stdc++.h>
+#include "../common/Fast_Input.h"
+#include "../common/Fast_Output.h"
 using namespace std;
 
+FastInput input;
+FastOutput output;
+
 vector<vector<int>> dp;
 vector<vector<int>> adj;
 
@@ -36,19 +41,20 @@ void dfs(int node, int parent) {
 
 int main() {
     int n;
-    cin >> n;
+    input >> n;
     dp.resize(n + 1, vector<int>(2, 0));
     adj.resize(n + 1);
     int u, v;
 
     for (int i = 1; i <= n - 1; i++) {
-        cin >> u >> v;
+        input >> u >> v;
         adj[u].push_back(v);
         adj[v].push_back(u);
     }
 
     dfs(1, 0);
-    cout << max(dp[1][0], dp[1][1]) << endl;
+    output << max(dp[1][0], dp[1][1]) << '\n';
 
+    output.flush();
     return 0;
 }